@@ -0,0 +1,202 @@
+/**
+ * \file CacheMotsFrequents.h
+ * \brief Ce fichier contient un petit cache des mots les plus demandés, placé devant l'arbre AVL du dictionnaire.
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef CACHE_MOTS_FREQUENTS_H_
+#define CACHE_MOTS_FREQUENTS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+namespace TP3
+{
+
+//classe représentant un cache associatif (4 voies) de pointeurs vers des noeuds, dont l'admission suit la
+//fréquence des mots estimée par une esquisse count-min à compteurs de 8 bits vieillissants (TinyLFU).
+//Un mot n'entre dans le cache que s'il est plus fréquent que le mot qu'il remplacerait : les mots rares
+//ne chassent pas les mots courants. Chaque ensemble occupe une ligne de cache.
+//Toutes les opérations sont sûres pour des lecteurs concurrents (atomiques relâchés). Un noeud trouvé
+//est toujours validé en comparant son mot, une course ne peut donc que rater le cache.
+//Le type Noeud doit avoir un membre std::string mot. Le propriétaire doit appeler vide() avant de
+//détruire un noeud qui pourrait être dans le cache.
+template <typename Noeud>
+class CacheMotsFrequents
+{
+public:
+
+	//Constructeur d'un cache vide
+	CacheMotsFrequents()
+	{
+		vide();
+		for (unsigned int b = 0; b < NB_BLOCS; b++)
+			for (unsigned int i = 0; i < 64; i++) esquisse[b].compteurs[i].store(0, std::memory_order_relaxed);
+		nbAcces.store(0, std::memory_order_relaxed);
+	}
+
+	//Chercher un mot dans le cache et compter l'accès dans l'esquisse de fréquences
+	//On retourne le noeud du mot s'il est dans le cache. Sinon, on retourne nullptr.
+	Noeud* cherche(std::string_view mot, std::size_t hachage)
+	{
+		std::uint32_t empreinte = _empreinte(hachage);
+		_compte(empreinte);
+
+		Ensemble &ensemble = ensembles[hachage % NB_ENSEMBLES];
+		for (unsigned int v = 0; v < VOIES; v++)
+		{
+			if (ensemble.empreintes[v].load(std::memory_order_relaxed) == empreinte)
+			{
+				Noeud *noeud = ensemble.noeuds[v].load(std::memory_order_acquire);
+				if (noeud != nullptr && noeud->mot == mot) return noeud;
+			}
+		}
+		return nullptr;
+	}
+
+	//Proposer au cache un noeud trouvé dans l'arbre après un échec de cherche
+	//Le noeud prend une voie libre, ou la place du mot le moins fréquent de l'ensemble s'il est plus fréquent que lui.
+	void propose(Noeud *noeud, std::size_t hachage)
+	{
+		std::uint32_t empreinte = _empreinte(hachage);
+		Ensemble &ensemble = ensembles[hachage % NB_ENSEMBLES];
+
+		unsigned int victime = VOIES;
+		for (unsigned int v = 0; v < VOIES; v++)
+		{
+			std::uint32_t autre = ensemble.empreintes[v].load(std::memory_order_relaxed);
+			if (autre == empreinte) return; // Déjà là (ou un mot de même empreinte)
+			if (autre == 0 && victime == VOIES) victime = v;
+		}
+
+		if (victime == VOIES)
+		{
+			// Ensemble plein : un mot vu une seule fois n'est pas admis, ce qui évite de consulter
+			// l'esquisse pour chaque voie dans le cas (fréquent) d'un mot rare
+			unsigned int frequence = _frequence(empreinte);
+			if (frequence <= 1) return;
+
+			unsigned int frequenceVictime = 256;
+			for (unsigned int v = 0; v < VOIES; v++)
+			{
+				unsigned int frequenceAutre = _frequence(ensemble.empreintes[v].load(std::memory_order_relaxed));
+				if (frequenceAutre < frequenceVictime)
+				{
+					victime = v;
+					frequenceVictime = frequenceAutre;
+				}
+			}
+			if (frequence <= frequenceVictime) return;
+		}
+
+		// L'empreinte est effacée pendant le changement : un lecteur ne voit jamais une empreinte avec un autre noeud
+		ensemble.empreintes[victime].store(0, std::memory_order_relaxed);
+		ensemble.noeuds[victime].store(noeud, std::memory_order_release);
+		ensemble.empreintes[victime].store(empreinte, std::memory_order_release);
+	}
+
+	//Vider le cache (les fréquences sont gardées)
+	//À appeler avant de détruire un noeud. Ne doit pas être concurrente avec cherche ou propose.
+	void vide()
+	{
+		for (unsigned int e = 0; e < NB_ENSEMBLES; e++)
+		{
+			for (unsigned int v = 0; v < VOIES; v++)
+			{
+				ensembles[e].empreintes[v].store(0, std::memory_order_relaxed);
+				ensembles[e].noeuds[v].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+	}
+
+private:
+
+	static const unsigned int NB_ENSEMBLES = 256;	// Nombre d'ensembles (1024 mots au total)
+	static const unsigned int VOIES = 4;		// Nombre de mots par ensemble
+	static const unsigned int PROFONDEUR = 4;	// Nombre de compteurs par mot dans l'esquisse count-min
+	static const unsigned int NB_BLOCS = 1024;	// Nombre de blocs de 64 compteurs de l'esquisse (puissance de 2)
+	static const unsigned int PERIODE = 16 * NB_ENSEMBLES * VOIES;	// Accès entre deux vieillissements
+
+	// Un ensemble du cache, aligné sur une ligne de cache (64 octets)
+	struct alignas(64) Ensemble
+	{
+		std::atomic<std::uint32_t> empreintes[VOIES];	// 0 : voie libre
+		std::atomic<Noeud*> noeuds[VOIES];
+	};
+
+	// Un bloc de l'esquisse : les compteurs d'un mot sont tous dans le même bloc, donc dans une seule ligne de cache
+	struct alignas(64) BlocEsquisse
+	{
+		std::atomic<std::uint8_t> compteurs[64];	// PROFONDEUR rangées de 16 compteurs, saturés à 255
+	};
+
+	Ensemble ensembles[NB_ENSEMBLES];
+	BlocEsquisse esquisse[NB_BLOCS];
+	std::atomic<std::uint32_t> nbAcces;			// Accès depuis le dernier vieillissement
+
+	// Empreinte non nulle de 32 bits, tirée des bits du hachage qui ne servent pas à choisir l'ensemble
+	static std::uint32_t _empreinte(std::size_t hachage)
+	{
+		std::uint64_t h = static_cast<std::uint64_t>(hachage) * 0x9E3779B97F4A7C15ULL;
+		return static_cast<std::uint32_t>(h >> 32) | 1;
+	}
+
+	// Compteur d'une empreinte dans une rangée de l'esquisse : le bloc est choisi par les bits forts
+	// de l'empreinte, la position dans chaque rangée du bloc par 4 bits différents des bits faibles
+	std::atomic<std::uint8_t> &_compteur(std::uint32_t empreinte, unsigned int rangee)
+	{
+		return esquisse[(empreinte >> 20) & (NB_BLOCS - 1)].compteurs[rangee * 16 + ((empreinte >> (4 * rangee + 1)) & 15)];
+	}
+	const std::atomic<std::uint8_t> &_compteur(std::uint32_t empreinte, unsigned int rangee) const
+	{
+		return esquisse[(empreinte >> 20) & (NB_BLOCS - 1)].compteurs[rangee * 16 + ((empreinte >> (4 * rangee + 1)) & 15)];
+	}
+
+	// Fréquence estimée : le plus petit des compteurs de l'empreinte
+	unsigned int _frequence(std::uint32_t empreinte) const
+	{
+		unsigned int minimum = 255;
+		for (unsigned int r = 0; r < PROFONDEUR; r++)
+		{
+			unsigned int compteur = _compteur(empreinte, r).load(std::memory_order_relaxed);
+			if (compteur < minimum) minimum = compteur;
+		}
+		return minimum;
+	}
+
+	// Compte un accès. Les compteurs sont incrémentés sans instruction atomique lecture-écriture :
+	// un accès concurrent peut être perdu, ce qui ne fait que rendre l'estimation un peu plus basse.
+	void _compte(std::uint32_t empreinte)
+	{
+		unsigned int minimum = _frequence(empreinte);
+		if (minimum < 255)
+		{
+			// Incrément conservateur : seuls les compteurs égaux au minimum augmentent
+			for (unsigned int r = 0; r < PROFONDEUR; r++)
+			{
+				std::atomic<std::uint8_t> &compteur = _compteur(empreinte, r);
+				if (compteur.load(std::memory_order_relaxed) == minimum) compteur.store(minimum + 1, std::memory_order_relaxed);
+			}
+		}
+
+		// Vieillissement : tous les PERIODE accès, les compteurs sont divisés par 2 (par un seul thread).
+		// Le nombre d'accès est lui aussi compté sans fetch_add, qui coûterait plus que le reste de _compte
+		std::uint32_t acces = nbAcces.load(std::memory_order_relaxed);
+		if (acces + 1 < PERIODE) nbAcces.store(acces + 1, std::memory_order_relaxed);
+		else if (nbAcces.compare_exchange_strong(acces, 0, std::memory_order_relaxed))
+		{
+			for (unsigned int b = 0; b < NB_BLOCS; b++)
+				for (unsigned int i = 0; i < 64; i++)
+					esquisse[b].compteurs[i].store(esquisse[b].compteurs[i].load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+		}
+	}
+};
+
+}
+
+#endif /* CACHE_MOTS_FREQUENTS_H_ */
@@ -0,0 +1,177 @@
+/**
+ * \file ChargeClient.cpp
+ * \brief Générateur de charge pour le service de traduction : mesure le débit (requêtes/s) et la latence (p50, p99)
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "Dictionnaire.h"
+#include "Protocole.h"
+
+using namespace std;
+using namespace TP3;
+
+typedef chrono::steady_clock Horloge;
+
+/**
+ * \brief Choisit la prochaine requête : surtout des traductions, quelques vérifications
+ * et quelques suggestions sur un mot mal écrit (une lettre remplacée).
+ * \param[in] mots Les mots du dictionnaire
+ * \param[in] generateur Le générateur aléatoire du thread
+ * \param[out] mot Le mot de la requête
+ * \return L'opération de la requête
+ */
+static Protocole::Operation choisitRequete(const vector<string> &mots, mt19937 &generateur, string &mot)
+{
+	mot = mots[generateur() % mots.size()];
+	unsigned int tirage = generateur() % 100;
+	if (tirage < 80) return Protocole::TRADUIT;
+	if (tirage < 98) return Protocole::APPARTIENT;
+	mot[generateur() % mot.size()] = static_cast<char>('a' + generateur() % 26);
+	return Protocole::SUGGERE;
+}
+
+/**
+ * \brief Lit exactement n octets d'une socket bloquante
+ * \return false si la connexion est fermée
+ */
+static bool lisExactement(int fd, char *tampon, size_t n)
+{
+	while (n > 0)
+	{
+		ssize_t lus = recv(fd, tampon, n, 0);
+		if (lus <= 0) return false;
+		tampon += lus;
+		n -= lus;
+	}
+	return true;
+}
+
+/**
+ * \brief Boucle d'une connexion : garde 'profondeur' requêtes en vol jusqu'à la fin, et note la latence de chacune
+ */
+static void chargeConnexion(const string &adresse, const vector<string> &mots, unsigned int profondeur,
+                            Horloge::time_point fin, unsigned int graine, vector<double> &latences, atomic<bool> &erreur)
+{
+	int fd = Protocole::connecte(adresse);
+	mt19937 generateur(graine);
+	deque<Horloge::time_point> enVol;
+	string requetes, mot, corps;
+	char entete[4];
+
+	while (!erreur.load())
+	{
+		// On complète le pipeline tant que la durée n'est pas écoulée
+		requetes.clear();
+		while (enVol.size() < profondeur && Horloge::now() < fin)
+		{
+			Protocole::Operation operation = choisitRequete(mots, generateur, mot);
+			Protocole::ajouteRequete(requetes, operation, mot);
+			enVol.push_back(Horloge::now());
+		}
+		if (!requetes.empty() && send(fd, requetes.data(), requetes.size(), MSG_NOSIGNAL) != (ssize_t) requetes.size())
+		{
+			erreur.store(true);
+			break;
+		}
+		if (enVol.empty()) break;
+
+		if (!lisExactement(fd, entete, 4))
+		{
+			erreur.store(true);
+			break;
+		}
+		corps.resize(Protocole::lisU32(entete));
+		if (!lisExactement(fd, &corps[0], corps.size()) || corps.empty() || corps[0] != Protocole::OK)
+		{
+			erreur.store(true);
+			break;
+		}
+		latences.push_back(chrono::duration<double, micro>(Horloge::now() - enVol.front()).count());
+		enVol.pop_front();
+	}
+	close(fd);
+}
+
+/**
+ * \brief Fonction principale du générateur de charge.
+ * \return 0 si le programme s'est terminé normalement, 1 sinon.
+ */
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		cerr << "Usage : " << argv[0] << " <port | chemin de socket Unix> <fichier du dictionnaire>"
+		     << " [connexions=8] [durée en s=5] [requêtes en vol par connexion=1]" << endl;
+		return 1;
+	}
+	string adresse = argv[1];
+	unsigned int nbConnexions = (argc > 3) ? stoi(argv[3]) : 8;
+	unsigned int duree = (argc > 4) ? stoi(argv[4]) : 5;
+	unsigned int profondeur = (argc > 5) ? stoi(argv[5]) : 1;
+
+	try
+	{
+		// Les mots des requêtes sont ceux du dictionnaire
+		ifstream englishFrench(argv[2]);
+		vector<string> mots;
+		string ligne, motAnglais, motTraduit;
+		while (getline(englishFrench, ligne))
+		{
+			if (Dictionnaire::lisLigne(ligne, motAnglais, motTraduit) && !motAnglais.empty()) mots.push_back(motAnglais);
+		}
+		if (mots.empty())
+		{
+			cerr << "Aucun mot dans '" << argv[2] << "'" << endl;
+			return 1;
+		}
+
+		vector<vector<double> > latences(nbConnexions);
+		vector<thread> threads;
+		atomic<bool> erreur(false);
+		Horloge::time_point debut = Horloge::now();
+		Horloge::time_point fin = debut + chrono::seconds(duree);
+		for (unsigned int c = 0; c < nbConnexions; c++)
+		{
+			threads.push_back(thread([&, c]()
+			{
+				try { chargeConnexion(adresse, mots, max(profondeur, 1u), fin, c + 1, latences[c], erreur); }
+				catch (exception &e) { cerr << e.what() << endl; erreur.store(true); }
+			}));
+		}
+		for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+		double secondes = chrono::duration<double>(Horloge::now() - debut).count();
+
+		vector<double> toutes;
+		for (size_t c = 0; c < latences.size(); c++) toutes.insert(toutes.end(), latences[c].begin(), latences[c].end());
+		if (erreur.load()) cerr << "Des connexions ont échoué : résultats partiels" << endl;
+		if (toutes.empty()) return 1;
+
+		sort(toutes.begin(), toutes.end());
+		cout << "Requêtes : " << toutes.size() << " en " << secondes << " s" << endl;
+		cout << "Débit : " << toutes.size() / secondes << " requêtes/s" << endl;
+		cout << "Latence p50 : " << toutes[toutes.size() / 2] << " us" << endl;
+		cout << "Latence p99 : " << toutes[toutes.size() * 99 / 100] << " us" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
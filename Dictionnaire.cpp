@@ -9,10 +9,20 @@
 
 #include "Dictionnaire.h"
 #include <algorithm> // pour std::min() dans le calcul de distance
+#include <future>    // pour le chargement en parallèle
+#include <iterator>
+#include <thread>
 
 // Limite du nombre de suggestions
 #define LIMITE_SUGGESTIONS 5
 
+// Taille minimale (en octets) d'un bloc du fichier analysé par un thread lors du chargement
+#define TAILLE_BLOC_MIN (1 << 20)
+
+// Hauteur minimale (environ 2^12 mots) d'un sous-arbre pour que les opérations ensemblistes
+// traitent ses deux moitiés dans deux threads
+#define HAUTEUR_PARALLELE 12
+
 namespace TP3
 {
     /**
@@ -20,80 +30,93 @@ namespace TP3
     * \brief Constructeur par défaut de la classe Dictionnaire
     * \post Un objet Dictionnaire vide est créé
     */
-    Dictionnaire::Dictionnaire() : racine(nullptr), cpt(0) {}
+    Dictionnaire::Dictionnaire() : racine(nullptr), cpt(0), indexInverseActif(false), indexInverseAJour(false), metrique(LEVENSHTEIN), cacheActif(true) {}
 
     /**
-     * \fn Dictionnaire::Dictionnaire(std::ifstream &fichier)
+     * \fn Dictionnaire::Dictionnaire(std::ifstream &fichier, bool avecIndexInverse)
      * \brief Constructeur de la classe Dictionnaire à partir d'un fichier
+     * \param[in] fichier Le fichier du dictionnaire
+     * \param[in] avecIndexInverse Si vrai, l'index français -> anglais est construit à la fin du chargement
      * \pre Le fichier doit être ouvert au préalable
      * \post Un objet Dictionnaire est créé à partir du fichier
+     * \post Le fichier est découpé en blocs (aux fins de ligne) analysés en parallèle, puis l'arbre
+     *       est construit d'un coup. Les mots et l'ordre de leurs traductions sont les mêmes
+     *       qu'en ajoutant les lignes une à une avec ajouteMot
+     * \post Le contenu du fichier est libéré dès que les blocs sont analysés, puis les blocs triés sont
+     *       fusionnés deux à deux (O(n log k) pour k blocs), chaque bloc étant libéré dès sa fusion
      */
-	Dictionnaire::Dictionnaire(std::ifstream &fichier): racine(nullptr), cpt(0)
+	Dictionnaire::Dictionnaire(std::ifstream &fichier, bool avecIndexInverse)
+        : racine(nullptr), cpt(0), indexInverseActif(false), indexInverseAJour(false), metrique(LEVENSHTEIN), cacheActif(true)
     {
         if (fichier)
         {
-            for( std::string ligneDico; getline( fichier, ligneDico); )
+            // On lit tout le fichier d'un coup
+            std::string contenu((std::istreambuf_iterator<char>(fichier)), std::istreambuf_iterator<char>());
+
+            // Un bloc par coeur, mais pas de blocs trop petits (un petit fichier est lu par un seul thread)
+            std::size_t nbBlocs = std::min<std::size_t>(std::thread::hardware_concurrency(), contenu.size() / TAILLE_BLOC_MIN);
+            std::vector<std::size_t> bornes(1, 0);
+            for (std::size_t b = 1; b < nbBlocs; b++)
             {
-                if (ligneDico[0] != '#') //Élimine les lignes d'en-tête
-                {
-                    // Le mot anglais est avant la tabulation (\t).
-                    std::string motAnglais = ligneDico.substr(0,ligneDico.find_first_of('\t'));
-                    
-                    // Le reste (définition) est après la tabulation (\t).
-                    std::string motTraduit = ligneDico.substr(motAnglais.length()+1, ligneDico.length()-1);
-
-                    //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
-                    std::size_t pos = motTraduit.find_first_of('[');
-                    while (pos!=std::string::npos)
-                    {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(']')-pos+1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('[');
-                    }
-                    
-                    //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
-                    pos = motTraduit.find_first_of('(');
-                    while (pos!=std::string::npos)
-                    {
-                        std::size_t longueur_crochet = motTraduit.find_first_of(')')-pos+1;
-                        motTraduit.replace(pos, longueur_crochet, "");
-                        pos = motTraduit.find_first_of('(');
-                    }
+                // Chaque bloc commence juste après une fin de ligne
+                std::size_t pos = contenu.find('\n', contenu.size() / nbBlocs * b);
+                if (pos == std::string::npos) break;
+                if (pos + 1 > bornes.back()) bornes.push_back(pos + 1);
+            }
+            bornes.push_back(contenu.size());
 
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posT = motTraduit.find_first_of('~');
-                    
-                    //Position d'un tilde, s'il y a lieu
-                    std::size_t posD = motTraduit.find_first_of(':');
-                    
-                    if (posD < posT)
-                    {
-                        //Quand le ':' est avant le '~', le mot français précède le ':'
-                        motTraduit = motTraduit.substr(0, posD);
-                    }
-                    
-                    else
-                    {
-                        //Quand le ':' est après le '~', le mot français suit le ':'
-                        if (posT < posD)
-                        {
-                            motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
-                        }
-                        else
-                        {
-                            //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
-                            motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
-                        }
-                    }
-                    
-                    //On ajoute le mot au dictionnaire
-                    ajouteMot(motAnglais, motTraduit);
-                    //std::cout<<motAnglais << " - " << motTraduit<<std::endl;
+            std::vector<std::future<std::vector<std::pair<std::string, std::string> > > > blocs;
+            for (std::size_t b = 1; b + 1 < bornes.size(); b++)
+            {
+                blocs.push_back(std::async(std::launch::async, &Dictionnaire::_lisBloc, std::cref(contenu), bornes[b], bornes[b + 1]));
+            }
+            std::vector<std::vector<std::pair<std::string, std::string> > > blocsLus;
+            blocsLus.push_back(_lisBloc(contenu, bornes[0], bornes[1]));
+            for (std::size_t b = 0; b < blocs.size(); b++) blocsLus.push_back(blocs[b].get());
+
+            // Les paires ont leurs propres chaînes : le contenu du fichier n'est plus nécessaire
+            std::string().swap(contenu);
+
+            // Chaque bloc est déjà trié. On fusionne les blocs voisins deux à deux, dans l'ordre du fichier,
+            // et la fusion stable garde l'ordre du fichier pour un même mot
+            while (blocsLus.size() > 1)
+            {
+                std::vector<std::vector<std::pair<std::string, std::string> > > fusionnes;
+                for (std::size_t b = 0; b + 1 < blocsLus.size(); b += 2)
+                {
+                    fusionnes.push_back(_fusionneBlocs(blocsLus[b], blocsLus[b + 1]));
                 }
+                if (blocsLus.size() % 2) fusionnes.push_back(std::move(blocsLus.back()));
+                blocsLus.swap(fusionnes);
             }
+            _construitDepuisPaires(blocsLus[0]);
         }
+        if (avecIndexInverse) activeIndexInverse();
 	}
 
+    /**
+     * \fn bool Dictionnaire::lisLigne(std::string_view ligneDico, std::string &motAnglais, std::string &motTraduit)
+     * \brief Analyse une ligne d'un fichier de dictionnaire au format IDP ("mot\tdéfinition")
+     * \param[in] ligneDico La ligne à analyser
+     * \param[out] motAnglais Le mot anglais (avant la tabulation)
+     * \param[out] motTraduit La traduction nettoyée (voir _extraitTraduction)
+     * \return false si la ligne est un commentaire ('#') ou n'a pas de tabulation, true sinon
+     */
+    bool Dictionnaire::lisLigne(std::string_view ligneDico, std::string &motAnglais, std::string &motTraduit)
+    {
+        if (ligneDico.empty() || ligneDico[0] == '#') return false; //Élimine les lignes d'en-tête
+
+        std::size_t tab = ligneDico.find_first_of('\t');
+        if (tab == std::string_view::npos) return false;
+
+        // Le mot anglais est avant la tabulation (\t).
+        motAnglais.assign(ligneDico.substr(0, tab));
+
+        // Le reste (définition) est après la tabulation (\t).
+        motTraduit = _extraitTraduction(std::string(ligneDico.substr(tab + 1)));
+        return true;
+    }
+
     /**
      * \fn Dictionnaire::~Dictionnaire()
      * \brief Destructeur de la classe Dictionnaire
@@ -115,11 +138,25 @@ namespace TP3
      */
     void Dictionnaire::ajouteMot(const std::string& motOriginal, const std::string& motTraduit)
     {
+        indexInverseAJour = false;
         _ajouteMot(racine, motOriginal, motTraduit);
     }
 
     /**
-     * \fn void Dictionnaire::supprimeMot(const std::string& motOriginal)
+     * \fn void Dictionnaire::ajouteMot(std::string &&motOriginal, std::string &&motTraduit)
+     * \brief Ajoute un mot au dictionnaire et l'une de ses traductions en déplaçant les chaînes dans l'arbre
+     * \param[in] motOriginal Le mot original, déplacé dans le nouveau noeud s'il est absent
+     * \param[in] motTraduit Le mot traduit, déplacé dans le noeud s'il n'y est pas déjà
+     * \post Comme l'autre ajouteMot, sans copier les chaînes
+     */
+    void Dictionnaire::ajouteMot(std::string &&motOriginal, std::string &&motTraduit)
+    {
+        indexInverseAJour = false;
+        _ajouteMot(racine, std::move(motOriginal), std::move(motTraduit));
+    }
+
+    /**
+     * \fn void Dictionnaire::supprimeMot(std::string_view motOriginal)
      * \brief Supprime un mot et ses traductions du dictionnaire en équilibrant l'arbre AVL
      * \param[in] motOriginal Le mot original à supprimer
      * \pre Le mot doit exister dans le dictionnaire
@@ -129,55 +166,285 @@ namespace TP3
      * \exception logic_error Si le mot n'existe pas dans le dictionnaire
      * \exception logic_error Si le dictionnaire est vide
      */
-    void Dictionnaire::supprimeMot(const std ::string& motOriginal)
+    void Dictionnaire::supprimeMot(std::string_view motOriginal)
     {
+        indexInverseAJour = false;
+        cacheMots.vide();
         _supprimeMot(racine, motOriginal);
     }
 
     /**
-     * \fn double Dictionnaire::similitude(const std::string& mot1, const std::string& mot2)
-     * \brief Calcule la similitude entre 2 mots (dans le dictionnaire ou pas) en utilisant l'algorithme de distance de Levenshtein
+     * \fn void Dictionnaire::appliqueDelta(std::ifstream &fichier)
+     * \brief Applique un fichier de modifications (delta) au dictionnaire en un seul lot
+     * \param[in] fichier Le fichier delta, ouvert au préalable
+     * \pre Chaque ligne non vide et non commentée ('#') est de la forme :
+     *      "+\tmot\tdéfinition" (ajoute le mot et/ou sa traduction, nettoyée comme au chargement),
+     *      "-\tmot\ttraduction" (retire cette traduction; le mot est retiré s'il n'en a plus) ou
+     *      "-\tmot" (retire le mot et toutes ses traductions)
+     * \pre Aucune lecture concurrente : le lot est appliqué en place (voir Dictionnaire.h)
+     * \post Les opérations sont appliquées dans l'ordre du fichier pour un même mot
+     * \post Retirer un mot ou une traduction absente ne fait rien
+     * \post L'arbre AVL est équilibré
+     * \exception logic_error Si une ligne est mal formée. Le dictionnaire n'est alors pas modifié
+     */
+    void Dictionnaire::appliqueDelta(std::ifstream &fichier)
+    {
+        // On lit tout le fichier avant de toucher à l'arbre : une ligne invalide n'applique rien
+        std::vector<OperationDelta> operations = _lisDelta(fichier);
+        _appliqueOperations(operations);
+    }
+
+    /**
+     * \fn std::vector<Dictionnaire::OperationDelta> Dictionnaire::_lisDelta(std::istream &fichier)
+     * \brief Méthode auxiliaire à appliqueDelta pour lire et valider toutes les lignes d'un fichier delta
+     * \param[in] fichier Le fichier delta
+     * \return Les opérations, dans l'ordre du fichier
+     * \exception logic_error Si une ligne est mal formée, y compris "-\tmot\t" (traduction à retirer vide)
+     */
+    std::vector<Dictionnaire::OperationDelta> Dictionnaire::_lisDelta(std::istream &fichier)
+    {
+        std::vector<OperationDelta> operations;
+        for (std::string ligne; getline(fichier, ligne); )
+        {
+            if (ligne.empty() || ligne[0] == '#') continue;
+
+            std::size_t tab1 = ligne.find_first_of('\t');
+            if ((ligne[0] != '+' && ligne[0] != '-') || tab1 != 1 || ligne.length() < 3)
+            {
+                throw std::logic_error("Ligne de delta mal formée : " + ligne);
+            }
+            std::size_t tab2 = ligne.find_first_of('\t', 2);
+
+            OperationDelta operation;
+            operation.ajout = (ligne[0] == '+');
+            operation.mot = ligne.substr(2, (tab2 == std::string::npos) ? std::string::npos : tab2 - 2);
+            if (tab2 != std::string::npos) operation.traduction = ligne.substr(tab2 + 1);
+
+            // Une tabulation annonce une traduction : elle ne peut pas être vide (sinon "-\tmot\t" retirerait tout le mot)
+            if (operation.mot.empty() || (operation.ajout && tab2 == std::string::npos)
+                || (!operation.ajout && tab2 != std::string::npos && operation.traduction.empty()))
+            {
+                throw std::logic_error("Ligne de delta mal formée : " + ligne);
+            }
+            if (operation.ajout) operation.traduction = _extraitTraduction(operation.traduction);
+            operations.push_back(operation);
+        }
+        return operations;
+    }
+
+    /**
+     * \fn void Dictionnaire::_appliqueOperations(std::vector<OperationDelta> &operations)
+     * \brief Méthode auxiliaire à appliqueDelta pour appliquer un lot d'opérations déjà validées
+     * \param[in] operations Les opérations, dans l'ordre du fichier (elles sont triées par mot)
+     * \post Comme appliqueDelta
+     */
+    void Dictionnaire::_appliqueOperations(std::vector<OperationDelta> &operations)
+    {
+        if (operations.empty()) return;
+        indexInverseAJour = false;
+        cacheMots.vide();
+
+        // Tri stable : les opérations d'un même mot gardent l'ordre du fichier
+        std::stable_sort(operations.begin(), operations.end(),
+                         [](const OperationDelta &a, const OperationDelta &b) { return a.mot < b.mot; });
+
+        // Petit lot : quelques descentes dans l'arbre coûtent moins cher qu'une reconstruction complète
+        if (operations.size() * (_hauteur(racine) + 2) < static_cast<std::size_t>(cpt) / 4)
+        {
+            for (std::size_t i = 0; i < operations.size(); i++)
+            {
+                _appliqueOperation(operations[i]);
+            }
+            return;
+        }
+
+        // Gros lot : on fusionne les noeuds (en ordre) avec les opérations triées,
+        // puis on reconstruit l'arbre équilibré une seule fois
+        std::vector<NoeudDictionnaire*> anciens;
+        anciens.reserve(cpt);
+        _aplatit(racine, anciens);
+
+        std::vector<NoeudDictionnaire*> noeuds;
+        noeuds.reserve(anciens.size() + operations.size());
+        std::size_t i = 0, j = 0;
+        while (i < anciens.size() || j < operations.size())
+        {
+            if (j == operations.size() || (i < anciens.size() && anciens[i]->mot < operations[j].mot))
+            {
+                noeuds.push_back(anciens[i++]);
+                continue;
+            }
+
+            // Toutes les opérations qui touchent ce mot, appliquées dans l'ordre
+            NoeudDictionnaire *noeud = nullptr;
+            if (i < anciens.size() && anciens[i]->mot == operations[j].mot) noeud = anciens[i++];
+            const std::string &mot = operations[j].mot;
+            for (; j < operations.size() && operations[j].mot == mot; j++)
+            {
+                const OperationDelta &operation = operations[j];
+                if (operation.ajout)
+                {
+                    if (noeud == nullptr) noeud = new NoeudDictionnaire(operation.mot, operation.traduction);
+                    else if (!_traductionEstPresente(noeud, operation.traduction)) noeud->traductions.push_back(operation.traduction);
+                }
+                else if (noeud != nullptr)
+                {
+                    if (!operation.traduction.empty())
+                    {
+                        std::vector<std::string> &traductions = noeud->traductions;
+                        traductions.erase(std::remove(traductions.begin(), traductions.end(), operation.traduction), traductions.end());
+                    }
+                    if (operation.traduction.empty() || noeud->traductions.empty())
+                    {
+                        delete noeud;
+                        noeud = nullptr;
+                    }
+                }
+            }
+            if (noeud != nullptr) noeuds.push_back(noeud);
+        }
+
+        racine = _construitEquilibre(noeuds, 0, noeuds.size());
+        cpt = noeuds.size();
+    }
+
+    /**
+     * \fn void Dictionnaire::supprimeMots(const std::vector<std::string> &mots)
+     * \brief Supprime plusieurs mots et leurs traductions du dictionnaire en équilibrant l'arbre AVL
+     * \param[in] mots Les mots à supprimer (dans n'importe quel ordre)
+     * \post Les mots donnés ne sont plus dans le dictionnaire. Ceux qui n'y étaient pas sont ignorés
+     * \post L'arbre AVL est équilibré
+     */
+    void Dictionnaire::supprimeMots(const std::vector<std::string> &mots)
+    {
+        indexInverseAJour = false;
+        cacheMots.vide();
+        std::vector<std::string> motsTries(mots);
+        std::sort(motsTries.begin(), motsTries.end());
+        motsTries.erase(std::unique(motsTries.begin(), motsTries.end()), motsTries.end());
+        int variation = 0;
+        racine = _differenceMots(racine, motsTries, 0, motsTries.size(), _niveauxParalleles(), variation);
+        cpt += variation;
+    }
+
+    /**
+     * \fn void Dictionnaire::fusionne(const Dictionnaire &autre)
+     * \brief Ajoute au dictionnaire tous les mots d'un autre dictionnaire (union)
+     * \param[in] autre Le dictionnaire à fusionner. Il n'est pas modifié
+     * \post Tous les mots de autre sont dans le dictionnaire
+     * \post Quand un mot est dans les deux dictionnaires, les traductions de autre absentes sont ajoutées à la suite
+     * \post L'arbre AVL est équilibré
+     */
+    void Dictionnaire::fusionne(const Dictionnaire &autre)
+    {
+        indexInverseAJour = false;
+        if (&autre == this) return;
+        int variation = 0;
+        racine = _union(racine, autre.racine, _niveauxParalleles(), variation);
+        cpt += variation;
+    }
+
+    /**
+     * \fn void Dictionnaire::intersecte(const Dictionnaire &autre)
+     * \brief Ne garde dans le dictionnaire que les mots qui sont aussi dans un autre dictionnaire (intersection)
+     * \param[in] autre L'autre dictionnaire. Il n'est pas modifié
+     * \post Seuls les mots présents dans les deux dictionnaires restent
+     * \post Les traductions de autre absentes sont ajoutées à la suite de celles des mots gardés
+     * \post L'arbre AVL est équilibré
+     */
+    void Dictionnaire::intersecte(const Dictionnaire &autre)
+    {
+        indexInverseAJour = false;
+        cacheMots.vide();
+        if (&autre == this) return;
+        int variation = 0;
+        racine = _intersection(racine, autre.racine, _niveauxParalleles(), variation);
+        cpt += variation;
+    }
+
+    /**
+     * \fn void Dictionnaire::soustrait(const Dictionnaire &autre)
+     * \brief Retire du dictionnaire tous les mots d'un autre dictionnaire (différence)
+     * \param[in] autre L'autre dictionnaire. Il n'est pas modifié
+     * \post Aucun mot de autre n'est dans le dictionnaire
+     * \post L'arbre AVL est équilibré
+     */
+    void Dictionnaire::soustrait(const Dictionnaire &autre)
+    {
+        indexInverseAJour = false;
+        cacheMots.vide();
+        if (&autre == this)
+        {
+            _detruireDictionnaire(racine);
+            return;
+        }
+        int variation = 0;
+        racine = _difference(racine, autre.racine, _niveauxParalleles(), variation);
+        cpt += variation;
+    }
+
+    /**
+     * \fn double Dictionnaire::similitude(std::string_view mot1, std::string_view mot2)
+     * \brief Calcule la similitude entre 2 mots (dans le dictionnaire ou pas) selon la métrique choisie
+     *        (distance de Levenshtein par défaut, voir Metriques.h)
      * \param[in] mot1 Le premier mot
      * \param[in] mot2 Le deuxième mot
      * \return La similitude entre les deux mots (entre 0 et 1)
      */
-    double Dictionnaire::similitude(const std::string& mot1, const std::string& mot2)
+    double Dictionnaire::similitude(std::string_view mot1, std::string_view mot2)
     {
-        // On utilise l'algorithme de distance de Levenshtein
-        // https://en.wikibooks.org/wiki/Algorithm_Implementation/Strings/Levenshtein_distance#C++
-        const std::size_t len1 = mot1.size(), len2 = mot2.size();
-        std::vector<std::vector<unsigned int>> d(len1 + 1, std::vector<unsigned int>(len2 + 1));
+        double resultat = 0.0;
+        _avecMetrique([&](auto politique) { resultat = Metriques::similitude<decltype(politique)>(mot1, mot2); });
+        return resultat;
+    }
 
-        d[0][0] = 0;
-        for(unsigned int i = 1; i <= len1; ++i) d[i][0] = i;
-        for(unsigned int i = 1; i <= len2; ++i) d[0][i] = i;
+    /**
+     * \fn void Dictionnaire::choisitMetrique(Metrique nouvelleMetrique)
+     * \brief Choisit la métrique de similitude utilisée par similitude et les suggestions de correction
+     * \param[in] nouvelleMetrique La métrique
+     * \post Les suggestions suivantes utilisent la distance et le seuil de cette métrique
+     */
+    void Dictionnaire::choisitMetrique(Metrique nouvelleMetrique)
+    {
+        metrique = nouvelleMetrique;
+    }
 
-        for(unsigned int i = 1; i <= len1; ++i)
-            for(unsigned int j = 1; j <= len2; ++j)
-                        // note that std::min({arg1, arg2, arg3}) works only in C++11,
-                        // for C++98 use std::min(std::min(arg1, arg2), arg3)
-                        d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (mot1[i - 1] == mot2[j - 1] ? 0 : 1) });
-        
-        // Ajout par rapport au site web. Changement de la distance en similitude
-        int dist = d[len1][len2];
-        int maxlen = (len1 > len2) ? len1 : len2;
-        return 1.0 - (double)dist / (double)maxlen;
+    /**
+     * \fn void Dictionnaire::activeCache(bool actif)
+     * \brief Active ou désactive le cache des mots fréquents devant l'arbre
+     * \param[in] actif Si faux, traduit et appartient cherchent toujours dans l'arbre
+     * \post Le cache est vidé : il ne contient que des noeuds trouvés pendant qu'il est actif
+     */
+    void Dictionnaire::activeCache(bool actif)
+    {
+        cacheMots.vide();
+        cacheActif = actif;
+    }
+
+    /**
+     * \fn Metrique Dictionnaire::metriqueChoisie() const
+     * \brief Retourne la métrique de similitude utilisée
+     * \return La métrique (LEVENSHTEIN par défaut)
+     */
+    Metrique Dictionnaire::metriqueChoisie() const
+    {
+        return metrique;
     }
 
     /**
-     * \fn std::vector<std::string> Dictionnaire::suggereCorrections(const std::string& motMalEcrit)
+     * \fn std::vector<std::string> Dictionnaire::suggereCorrections(std::string_view motMalEcrit)
      * \brief Suggère jusqu'à 5 corrections pour un mot mal écrit
      * \param[in] motMalEcrit Le mot mal écrit
      * \return Un vecteur de chaînes de caractères contenant les suggestions de corrections
      * \post Si le mot mal écrit existe dans le dictionnaire, le vecteur retourné est vide
      * \post Si le mot mal écrit n'existe pas dans le dictionnaire, le vecteur retourné contient les suggestions de corrections
      */
-    std::vector<std::string> Dictionnaire::suggereCorrections(const std ::string& motMalEcrit)
+    std::vector<std::string> Dictionnaire::suggereCorrections(std::string_view motMalEcrit)
     {
         std::vector<std::string> suggestions;
         if (appartient(motMalEcrit)) return suggestions;
 
-        _suggereCorrections(racine, motMalEcrit, suggestions);
+        _avecMetrique([&](auto politique) { _suggereCorrections<decltype(politique)>(racine, motMalEcrit, suggestions); });
         if (suggestions.size() > LIMITE_SUGGESTIONS)
         {
             suggestions.erase(suggestions.begin() + LIMITE_SUGGESTIONS, suggestions.end());
@@ -186,20 +453,98 @@ namespace TP3
     }
 
     /**
-     * \fn std::vector<std::string> Dictionnaire::traduit(const std::string& mot)
+     * \fn std::vector<std::string> Dictionnaire::suggereCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations, std::chrono::microseconds delai, bool &estExhaustif)
+     * \brief Suggère jusqu'à 5 corrections pour un mot mal écrit, en un temps borné
+     * \param[in] motMalEcrit Le mot mal écrit
+     * \param[in] budgetEvaluations Le nombre maximal d'appels à similitude (0 : pas de limite)
+     * \param[in] delai Le temps maximal de la recherche (0 : pas de limite)
+     * \param[out] estExhaustif true si tous les candidats ont été évalués
+     * \return Les meilleures corrections trouvées (similitude d'au moins le seuil de la métrique), de la plus
+     *         similaire à la moins similaire, puis en ordre alphabétique
+     * \post Si le mot mal écrit existe dans le dictionnaire, le vecteur retourné est vide (et estExhaustif est true)
+     * \post Les mots dont la différence de longueur rend le seuil impossible à atteindre ne sont pas évalués.
+     *       Les autres le sont par différence de longueur croissante, puis par préfixe commun décroissant
+     */
+    std::vector<std::string> Dictionnaire::suggereCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations,
+                                                              std::chrono::microseconds delai, bool &estExhaustif)
+    {
+        std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+        std::vector<std::string> suggestions;
+        estExhaustif = true;
+        if (appartient(motMalEcrit)) return suggestions;
+
+        _avecMetrique([&](auto politique)
+        {
+            _meilleuresCorrections<decltype(politique)>(motMalEcrit, budgetEvaluations, delai, debut, estExhaustif, suggestions);
+        });
+        return suggestions;
+    }
+
+    /**
+     * \fn void Dictionnaire::_meilleuresCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations, std::chrono::microseconds delai, std::chrono::steady_clock::time_point debut, bool &estExhaustif, std::vector<std::string> &suggestions)
+     * \brief Méthode auxiliaire de suggereCorrections avec budget, pour la métrique M
+     * \param[in] motMalEcrit Le mot mal écrit (absent du dictionnaire)
+     * \param[in] budgetEvaluations Le nombre maximal de calculs de similitude (0 : pas de limite)
+     * \param[in] delai Le temps maximal de la recherche (0 : pas de limite)
+     * \param[in] debut Le début de la recherche
+     * \param[out] estExhaustif false si la recherche a été interrompue
+     * \param[out] suggestions Les meilleures corrections trouvées
+     */
+    template <typename M>
+    void Dictionnaire::_meilleuresCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations, std::chrono::microseconds delai,
+                                              std::chrono::steady_clock::time_point debut, bool &estExhaustif, std::vector<std::string> &suggestions)
+    {
+        // Clé de tri de chaque candidat : son rang, puis sa position alphabétique (pour départager les égalités)
+        std::vector<NoeudDictionnaire*> candidats;
+        std::vector<std::uint64_t> ordre;
+        _candidatsCorrections<M>(racine, motMalEcrit, candidats, ordre);
+        std::sort(ordre.begin(), ordre.end());
+
+        // Les meilleures corrections jusqu'ici, de la plus similaire à la moins similaire
+        std::vector<std::pair<double, NoeudDictionnaire*> > meilleures;
+        for (std::size_t i = 0; i < ordre.size(); i++)
+        {
+            if ((budgetEvaluations != 0 && i == budgetEvaluations)
+                || (delai.count() != 0 && i % 16 == 0 && std::chrono::steady_clock::now() - debut >= delai))
+            {
+                estExhaustif = false;
+                break;
+            }
+
+            NoeudDictionnaire *noeud = candidats[static_cast<std::uint32_t>(ordre[i])];
+            double sim = Metriques::similitude<M>(motMalEcrit, noeud->mot);
+            if (sim < M::SEUIL) continue;
+
+            std::pair<double, NoeudDictionnaire*> correction(sim, noeud);
+            std::vector<std::pair<double, NoeudDictionnaire*> >::iterator position =
+                std::upper_bound(meilleures.begin(), meilleures.end(), correction,
+                                 [](const std::pair<double, NoeudDictionnaire*> &a, const std::pair<double, NoeudDictionnaire*> &b)
+                                 { return a.first > b.first || (a.first == b.first && a.second->mot < b.second->mot); });
+            if (position - meilleures.begin() < LIMITE_SUGGESTIONS)
+            {
+                meilleures.insert(position, correction);
+                if (meilleures.size() > LIMITE_SUGGESTIONS) meilleures.pop_back();
+            }
+        }
+
+        for (std::size_t i = 0; i < meilleures.size(); i++) suggestions.push_back(meilleures[i].second->mot);
+    }
+
+    /**
+     * \fn std::vector<std::string> Dictionnaire::traduit(std::string_view mot)
      * \brief Retourne les traductions possibles d'un mot
      * \param[in] mot Le mot à traduire
      * \return Un vecteur de chaînes de caractères contenant les traductions possibles du mot
      * \post Si le mot n'existe pas dans le dictionnaire, le vecteur retourné est vide
      * \post Si le mot existe dans le dictionnaire, le vecteur retourné contient les traductions présentes dans le dictionnaire
      */
-    std::vector<std::string> Dictionnaire::traduit(const std ::string& mot)
+    std::vector<std::string> Dictionnaire::traduit(std::string_view mot)
     {
         //Trouver les traductions possibles d'un mot
 	    //Si le mot appartient au dictionnaire, on retourne le vecteur des traductions du mot donné.
 	    //Sinon, on retourne un vecteur vide
         std::vector<std::string> traductions;
-        NoeudDictionnaire* noeud = _accedeMot(racine, mot);
+        NoeudDictionnaire* noeud = _accedeMotCache(mot);
         if (noeud != nullptr)
         {
             traductions = noeud->traductions;
@@ -208,14 +553,99 @@ namespace TP3
     }
 
     /**
-     * \fn bool Dictionnaire::appartient(const std::string& mot)
+     * \fn bool Dictionnaire::appartient(std::string_view mot)
      * \brief Vérifie si un mot appartient au dictionnaire
      * \param[in] mot Le mot à vérifier
      * \return true si le mot appartient au dictionnaire, false sinon
      */
-    bool Dictionnaire::appartient(const std::string &mot)
+    bool Dictionnaire::appartient(std::string_view mot)
+    {
+        return _accedeMotCache(mot) != nullptr;
+    }
+
+    /**
+     * \fn void Dictionnaire::activeIndexInverse()
+     * \brief Active l'index inverse (français -> anglais) et le construit
+     * \post traduitInverse, appartientInverse et suggereCorrectionsInverse peuvent être utilisées
+     * \post L'index partage les chaînes des noeuds. Il est reconstruit à la prochaine requête
+     *       inverse après une modification du dictionnaire (par un seul lecteur à la fois)
+     */
+    void Dictionnaire::activeIndexInverse()
+    {
+        indexInverseActif = true;
+        _majIndexInverse();
+    }
+
+    /**
+     * \fn std::vector<std::string> Dictionnaire::traduitInverse(std::string_view motFrancais)
+     * \brief Retourne les mots anglais dont un mot français est une traduction
+     * \param[in] motFrancais Le mot français
+     * \return Les mots anglais, en ordre alphabétique (vecteur vide si aucun)
+     * \exception logic_error Si l'index inverse n'est pas activé
+     */
+    std::vector<std::string> Dictionnaire::traduitInverse(std::string_view motFrancais)
+    {
+        _majIndexInverse();
+        std::vector<std::string> mots;
+        std::vector<EntreeInverse>::const_iterator it = std::lower_bound(indexInverse.begin(), indexInverse.end(), motFrancais,
+            [](const EntreeInverse &entree, std::string_view mot) { return entree.traduction < mot; });
+        for (; it != indexInverse.end() && it->traduction == motFrancais; ++it)
+        {
+            if (mots.empty() || mots.back() != it->noeud->mot) mots.push_back(it->noeud->mot);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn bool Dictionnaire::appartientInverse(std::string_view motFrancais)
+     * \brief Vérifie si un mot français est la traduction d'au moins un mot du dictionnaire
+     * \param[in] motFrancais Le mot français
+     * \return true si le mot français est une traduction, false sinon
+     * \exception logic_error Si l'index inverse n'est pas activé
+     */
+    bool Dictionnaire::appartientInverse(std::string_view motFrancais)
+    {
+        _majIndexInverse();
+        std::vector<EntreeInverse>::const_iterator it = std::lower_bound(indexInverse.begin(), indexInverse.end(), motFrancais,
+            [](const EntreeInverse &entree, std::string_view mot) { return entree.traduction < mot; });
+        return it != indexInverse.end() && it->traduction == motFrancais;
+    }
+
+    /**
+     * \fn std::vector<std::string> Dictionnaire::suggereCorrectionsInverse(std::string_view motMalEcrit)
+     * \brief Suggère jusqu'à 5 corrections pour un mot français mal écrit, parmi les traductions du dictionnaire
+     * \param[in] motMalEcrit Le mot français mal écrit
+     * \return Les suggestions, en ordre alphabétique
+     * \post Si le mot est déjà une traduction, le vecteur retourné est vide
+     * \exception logic_error Si l'index inverse n'est pas activé
+     */
+    std::vector<std::string> Dictionnaire::suggereCorrectionsInverse(std::string_view motMalEcrit)
     {
-        return _accedeMot(racine, mot) != nullptr;
+        std::vector<std::string> suggestions;
+        if (appartientInverse(motMalEcrit)) return suggestions;
+
+        _avecMetrique([&](auto politique) { _suggereCorrectionsInverse<decltype(politique)>(motMalEcrit, suggestions); });
+        return suggestions;
+    }
+
+    /**
+     * \fn void Dictionnaire::_suggereCorrectionsInverse(std::string_view motMalEcrit, std::vector<std::string> &suggestions)
+     * \brief Méthode auxiliaire de suggereCorrectionsInverse, pour la métrique M
+     * \param[in] motMalEcrit Le mot français mal écrit
+     * \param[out] suggestions Les 5 premières traductions (en ordre alphabétique) assez similaires
+     */
+    template <typename M>
+    void Dictionnaire::_suggereCorrectionsInverse(std::string_view motMalEcrit, std::vector<std::string> &suggestions)
+    {
+        for (std::size_t i = 0; i < indexInverse.size() && suggestions.size() < LIMITE_SUGGESTIONS; i++)
+        {
+            // Les entrées sont triées : on ne compare qu'une fois chaque traduction distincte
+            if (i > 0 && indexInverse[i].traduction == indexInverse[i - 1].traduction) continue;
+            if (Metriques::similitude<M>(motMalEcrit, indexInverse[i].traduction) >= M::SEUIL)
+            {
+                suggestions.push_back(std::string(indexInverse[i].traduction));
+            }
+        }
     }
 
     /**
@@ -254,7 +684,7 @@ namespace TP3
      * \fn void Dictionnaire::_detruireDictionnaire(NoeudDictionnaire * &arbre)
      * \brief Méthode auxiliaire au destructeur pour détruire récursivement le dictionnaire
      * \param[in] arbre Le sous-arbre à détruire récursivement
-     * \post Le noeud et ses sous-arbres sont détruits
+     * \post Le noeud et ses sous-arbres sont détruits et le nombre de mots est mis à jour
      */
     void Dictionnaire::_detruireDictionnaire(NoeudDictionnaire * &arbre)
     {
@@ -264,18 +694,163 @@ namespace TP3
             _detruireDictionnaire(arbre->droite);
             delete arbre;
             arbre = nullptr;
+            --cpt;
         }
     }
 
     /**
-     * \fn bool Dictionnaire::_ajouteMot(NoeudDictionnaire * &arbre, const std::string &motOriginal, const std::string &motTraduit)
+     * \fn std::string Dictionnaire::_extraitTraduction(std::string motTraduit)
+     * \brief Méthode auxiliaire au chargement pour extraire le mot français d'une définition au format IDP
+     * \param[in] motTraduit La définition (ce qui suit la tabulation sur une ligne du fichier)
+     * \return La traduction nettoyée (sans crochets, parenthèses ni exemples)
+     */
+    std::string Dictionnaire::_extraitTraduction(std::string motTraduit)
+    {
+        //On élimine tout ce qui est entre crochets [] (possibilité de 2 ou plus)
+        std::size_t pos = motTraduit.find_first_of('[');
+        while (pos!=std::string::npos)
+        {
+            std::size_t longueur_crochet = motTraduit.find_first_of(']')-pos+1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('[');
+        }
+        
+        //On élimine tout ce qui est entre deux parenthèses () (possibilité de 2 ou plus)
+        pos = motTraduit.find_first_of('(');
+        while (pos!=std::string::npos)
+        {
+            std::size_t longueur_crochet = motTraduit.find_first_of(')')-pos+1;
+            motTraduit.replace(pos, longueur_crochet, "");
+            pos = motTraduit.find_first_of('(');
+        }
+
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posT = motTraduit.find_first_of('~');
+        
+        //Position d'un tilde, s'il y a lieu
+        std::size_t posD = motTraduit.find_first_of(':');
+        
+        if (posD < posT)
+        {
+            //Quand le ':' est avant le '~', le mot français précède le ':'
+            motTraduit = motTraduit.substr(0, posD);
+        }
+        
+        else
+        {
+            //Quand le ':' est après le '~', le mot français suit le ':'
+            if (posT < posD)
+            {
+                motTraduit = motTraduit.substr(posD, motTraduit.find_first_of("([,;\n", posD));
+            }
+            else
+            {
+                //Quand il n'y a ni ':' ni '~', on extrait simplement ce qu'il y a avant un caractère de limite
+                motTraduit = motTraduit.substr(0, motTraduit.find_first_of("([,;\n"));
+            }
+        }
+
+        return motTraduit;
+    }
+
+    /**
+     * \fn std::vector<std::pair<std::string, std::string> > Dictionnaire::_lisBloc(const std::string &contenu, std::size_t debut, std::size_t fin)
+     * \brief Méthode auxiliaire au chargement pour analyser un bloc de lignes (exécutée par un thread par bloc)
+     * \param[in] contenu Le contenu complet du fichier
+     * \param[in] debut La position du début du bloc (début d'une ligne)
+     * \param[in] fin La position suivant la fin du bloc
+     * \return Les paires (mot anglais, traduction) du bloc, triées par mot de façon stable
+     */
+    std::vector<std::pair<std::string, std::string> > Dictionnaire::_lisBloc(const std::string &contenu, std::size_t debut, std::size_t fin)
+    {
+        std::vector<std::pair<std::string, std::string> > paires;
+        std::string motAnglais, motTraduit;
+        while (debut < fin)
+        {
+            std::size_t finLigne = contenu.find('\n', debut);
+            if (finLigne == std::string::npos || finLigne > fin) finLigne = fin;
+            // La ligne est lue sur place, et les mots extraits sont déplacés dans la paire
+            if (lisLigne(std::string_view(contenu).substr(debut, finLigne - debut), motAnglais, motTraduit))
+            {
+                paires.push_back(std::make_pair(std::move(motAnglais), std::move(motTraduit)));
+            }
+            debut = finLigne + 1;
+        }
+        std::stable_sort(paires.begin(), paires.end(), _comparePaires);
+        return paires;
+    }
+
+    /**
+     * \fn std::vector<std::pair<std::string, std::string> > Dictionnaire::_fusionneBlocs(std::vector<std::pair<std::string, std::string> > &premier, std::vector<std::pair<std::string, std::string> > &second)
+     * \brief Méthode auxiliaire au chargement pour fusionner deux blocs triés voisins
+     * \param[in,out] premier Le bloc qui précède dans le fichier (libéré après la fusion)
+     * \param[in,out] second Le bloc qui suit dans le fichier (libéré après la fusion)
+     * \return Les paires des deux blocs, triées par mot. Pour un même mot, celles du premier bloc d'abord
+     * \post Les chaînes sont déplacées, pas copiées
+     */
+    std::vector<std::pair<std::string, std::string> > Dictionnaire::_fusionneBlocs(std::vector<std::pair<std::string, std::string> > &premier, std::vector<std::pair<std::string, std::string> > &second)
+    {
+        std::vector<std::pair<std::string, std::string> > paires;
+        paires.reserve(premier.size() + second.size());
+        std::merge(std::make_move_iterator(premier.begin()), std::make_move_iterator(premier.end()),
+                   std::make_move_iterator(second.begin()), std::make_move_iterator(second.end()),
+                   std::back_inserter(paires), _comparePaires);
+        std::vector<std::pair<std::string, std::string> >().swap(premier);
+        std::vector<std::pair<std::string, std::string> >().swap(second);
+        return paires;
+    }
+
+    /**
+     * \fn bool Dictionnaire::_comparePaires(const std::pair<std::string, std::string> &a, const std::pair<std::string, std::string> &b)
+     * \brief Méthode auxiliaire au chargement pour trier les paires (mot, traduction) selon le mot seulement
+     * \param[in] a La première paire
+     * \param[in] b La deuxième paire
+     * \return true si le mot de a précède celui de b
+     */
+    bool Dictionnaire::_comparePaires(const std::pair<std::string, std::string> &a, const std::pair<std::string, std::string> &b)
+    {
+        return a.first < b.first;
+    }
+
+    /**
+     * \fn void Dictionnaire::_construitDepuisPaires(std::vector<std::pair<std::string, std::string> > &paires)
+     * \brief Méthode auxiliaire au chargement pour construire l'arbre d'un coup à partir de paires triées
+     * \param[in,out] paires Les paires (mot, traduction), triées par mot. Leurs chaînes sont déplacées dans les noeuds
+     *                     et le vecteur est libéré
+     * \pre Le dictionnaire est vide
+     * \post Chaque mot a ses traductions sans doublons, dans l'ordre des paires
+     * \post L'arbre AVL est parfaitement équilibré
+     */
+    void Dictionnaire::_construitDepuisPaires(std::vector<std::pair<std::string, std::string> > &paires)
+    {
+        std::vector<NoeudDictionnaire*> noeuds;
+        for (std::size_t i = 0; i < paires.size(); i++)
+        {
+            if (noeuds.empty() || noeuds.back()->mot != paires[i].first)
+            {
+                noeuds.push_back(new NoeudDictionnaire(std::move(paires[i].first), std::move(paires[i].second)));
+            }
+            else if (!_traductionEstPresente(noeuds.back(), paires[i].second))
+            {
+                noeuds.back()->traductions.push_back(std::move(paires[i].second));
+            }
+        }
+        std::vector<std::pair<std::string, std::string> >().swap(paires);
+        racine = _construitEquilibre(noeuds, 0, noeuds.size());
+        cpt = noeuds.size();
+    }
+
+    /**
+     * \fn bool Dictionnaire::_ajouteMot(NoeudDictionnaire * &arbre, Mot &&motOriginal, Traduction &&motTraduit)
      * \brief Méthode auxiliaire à ajouteMot pour ajouter un mot au dictionnaire par récursivité
      * \param[in] arbre Le noeud à ajouter
      * \param[in] motOriginal Le mot original à ajouter
      * \param[in] motTraduit Le mot traduit à ajouter
      * \return true si un nouveau mot a été ajouté, false sinon
+     * \post Une chaîne passée en rvalue est déplacée (au plus une fois, là où elle est stockée), sinon copiée
      */
-    bool Dictionnaire::_ajouteMot(NoeudDictionnaire * &arbre, const std::string &motOriginal, const std::string &motTraduit)
+    template <typename Mot, typename Traduction>
+    bool Dictionnaire::_ajouteMot(NoeudDictionnaire * &arbre, Mot &&motOriginal, Traduction &&motTraduit)
     {   
         // Indique si un mot, et pas seulement une traduction, a été ajouté
         // Permet de ne pas équilibrer l'arbre si c'est seulement une traduction qui a été ajoutée
@@ -283,22 +858,22 @@ namespace TP3
 
         if (arbre == nullptr)
         {
-            arbre = new NoeudDictionnaire(motOriginal, motTraduit);
+            arbre = new NoeudDictionnaire(std::forward<Mot>(motOriginal), std::forward<Traduction>(motTraduit));
             cpt++;
             return true; // Se propage aux 'nvMotEstAjoute' jusqu'à la racine
         }
         
         if (motOriginal < arbre->mot)
         {
-            nvMotEstAjoute = _ajouteMot(arbre->gauche, motOriginal, motTraduit);
+            nvMotEstAjoute = _ajouteMot(arbre->gauche, std::forward<Mot>(motOriginal), std::forward<Traduction>(motTraduit));
         }
         else if (motOriginal > arbre->mot)
         {
-            nvMotEstAjoute = _ajouteMot(arbre->droite, motOriginal, motTraduit);
+            nvMotEstAjoute = _ajouteMot(arbre->droite, std::forward<Mot>(motOriginal), std::forward<Traduction>(motTraduit));
         }
         else // Le mot existe déjà
         {
-            if (!_traductionEstPresente(arbre, motTraduit)) arbre->traductions.push_back(motTraduit);
+            if (!_traductionEstPresente(arbre, motTraduit)) arbre->traductions.push_back(std::forward<Traduction>(motTraduit));
             return false; // Se propage aux 'nvMotEstAjoute' jusqu'à la racine
         }
 
@@ -308,14 +883,14 @@ namespace TP3
     }
 
     /**
-     * \fn bool Dictionnaire::_traductionEstPresente(NoeudDictionnaire * &noeud, const std::string &motTraduit) const
+     * \fn bool Dictionnaire::_traductionEstPresente(NoeudDictionnaire * &noeud, std::string_view motTraduit) const
      * \brief Méthode auxiliaire à ajouteMot pour savoir si un mot a déjà une traduction donnée
      * \param[in] noeud Le noeud à vérifier
      * \param[in] motTraduit Le mot traduit à vérifier
      * \return true si le mot a déjà la traduction donnée, false sinon
      * \pre Le noeud existe
      */
-    bool Dictionnaire::_traductionEstPresente(NoeudDictionnaire * &noeud, const std::string &motTraduit) const
+    bool Dictionnaire::_traductionEstPresente(NoeudDictionnaire * &noeud, std::string_view motTraduit) const
     {   
         if (noeud == nullptr) throw std::logic_error("Le noeud n'existe pas");
         else
@@ -329,7 +904,7 @@ namespace TP3
     }
 
     /**
-     * \fn void Dictionnaire::_supprimeMot(NoeudDictionnaire * &arbre, const std::string &motOriginal)
+     * \fn void Dictionnaire::_supprimeMot(NoeudDictionnaire * &arbre, std::string_view motOriginal)
      * \brief Méthode auxiliaire à supprimeMot pour supprimer un mot du dictionnaire par récursivité
      * \param[in] arbre Le sous-arbre dans lequel chercher le mot
      * \param[in] motOriginal Le mot original à supprimer
@@ -339,7 +914,7 @@ namespace TP3
      * \exception logic_error Le dictionnaire est vide
      * \exception logic_error Le mot n'existe pas dans le dictionnaire
      */
-    void Dictionnaire::_supprimeMot(NoeudDictionnaire * &arbre, const std::string &motOriginal)
+    void Dictionnaire::_supprimeMot(NoeudDictionnaire * &arbre, std::string_view motOriginal)
     {
         if (estVide())
         {
@@ -378,31 +953,530 @@ namespace TP3
      * \param[in] arbre Le noeud à supprimer
      * \pre Le noeud a deux enfants
      * \post Le noeud est supprimé du dictionnaire et remplacé par le plus petit mot de l'arbre droit
+     * \post Le chemin vers le plus petit mot de l'arbre droit est rééquilibré
      */
     void Dictionnaire::_enleveMinDroite(NoeudDictionnaire * &arbre)
     {
-        NoeudDictionnaire *temp = arbre->droite;
-        NoeudDictionnaire *parent = arbre;
-        while (temp->gauche != nullptr)
+        // On détache le plus petit noeud de l'arbre droit en une seule descente,
+        // et on le met à la place du noeud supprimé (avec son mot et ses traductions)
+        NoeudDictionnaire *min = _detacheMin(arbre->droite);
+        min->gauche = arbre->gauche;
+        min->droite = arbre->droite;
+        delete arbre;
+        arbre = min;
+        --cpt;
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_detacheMin(NoeudDictionnaire * &arbre)
+     * \brief Méthode auxiliaire à _enleveMinDroite pour détacher le plus petit noeud d'un sous-arbre
+     * \param[in] arbre Le sous-arbre
+     * \pre Le sous-arbre n'est pas vide
+     * \return Le noeud détaché (sans enfants)
+     * \post Le sous-arbre est rééquilibré et ses hauteurs sont mises à jour
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_detacheMin(NoeudDictionnaire * &arbre)
+    {
+        if (arbre->gauche == nullptr)
+        {
+            NoeudDictionnaire *min = arbre;
+            arbre = arbre->droite;
+            min->droite = nullptr;
+            return min;
+        }
+        NoeudDictionnaire *min = _detacheMin(arbre->gauche);
+        _equilibreAVL(arbre);
+        return min;
+    }
+
+    /**
+     * \fn void Dictionnaire::_appliqueOperation(const OperationDelta &operation)
+     * \brief Méthode auxiliaire à appliqueDelta pour appliquer une seule opération par les méthodes habituelles
+     * \param[in] operation L'opération à appliquer
+     * \post L'opération est appliquée et l'arbre AVL est équilibré
+     */
+    void Dictionnaire::_appliqueOperation(const OperationDelta &operation)
+    {
+        if (operation.ajout)
+        {
+            ajouteMot(operation.mot, operation.traduction);
+            return;
+        }
+
+        NoeudDictionnaire *noeud = _accedeMot(racine, operation.mot);
+        if (noeud == nullptr) return;
+        if (!operation.traduction.empty())
+        {
+            std::vector<std::string> &traductions = noeud->traductions;
+            traductions.erase(std::remove(traductions.begin(), traductions.end(), operation.traduction), traductions.end());
+        }
+        if (operation.traduction.empty() || noeud->traductions.empty()) supprimeMot(operation.mot);
+    }
+
+    /**
+     * \fn void Dictionnaire::_aplatit(NoeudDictionnaire * const &arbre, std::vector<NoeudDictionnaire*> &noeuds) const
+     * \brief Méthode privée pour récupérer les noeuds d'un sous-arbre en ordre (parcours infixe)
+     * \param[in] arbre Le sous-arbre à parcourir
+     * \param[out] noeuds Le vecteur auquel les noeuds sont ajoutés, en ordre croissant des mots
+     */
+    void Dictionnaire::_aplatit(NoeudDictionnaire * const &arbre, std::vector<NoeudDictionnaire*> &noeuds) const
+    {
+        if (arbre == nullptr) return;
+        _aplatit(arbre->gauche, noeuds);
+        noeuds.push_back(arbre);
+        _aplatit(arbre->droite, noeuds);
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_construitEquilibre(std::vector<NoeudDictionnaire*> &noeuds, std::size_t debut, std::size_t fin)
+     * \brief Méthode privée pour relier des noeuds triés en un arbre parfaitement équilibré, en O(n)
+     * \param[in] noeuds Les noeuds, en ordre croissant des mots
+     * \param[in] debut L'indice du premier noeud du sous-arbre
+     * \param[in] fin L'indice suivant le dernier noeud du sous-arbre
+     * \return La racine du sous-arbre construit (nullptr s'il est vide)
+     * \post Les enfants et les hauteurs des noeuds sont mis à jour
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_construitEquilibre(std::vector<NoeudDictionnaire*> &noeuds, std::size_t debut, std::size_t fin)
+    {
+        if (debut >= fin) return nullptr;
+        std::size_t milieu = debut + (fin - debut) / 2;
+        NoeudDictionnaire *arbre = noeuds[milieu];
+        arbre->gauche = _construitEquilibre(noeuds, debut, milieu);
+        arbre->droite = _construitEquilibre(noeuds, milieu + 1, fin);
+        int max = (_hauteur(arbre->gauche) > _hauteur(arbre->droite)) ? _hauteur(arbre->gauche) : _hauteur(arbre->droite);
+        arbre->hauteur = 1 + max;
+        return arbre;
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_joint(NoeudDictionnaire *gauche, NoeudDictionnaire *noeud, NoeudDictionnaire *droite)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour joindre deux arbres AVL autour d'un noeud
+     * \param[in] gauche Un arbre AVL dont tous les mots précèdent celui du noeud
+     * \param[in] noeud Le noeud du milieu (ses enfants sont ignorés)
+     * \param[in] droite Un arbre AVL dont tous les mots suivent celui du noeud
+     * \return La racine de l'arbre AVL joint
+     * \post On descend seulement le long du côté du plus haut des deux arbres : O(|h(gauche) - h(droite)|)
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_joint(NoeudDictionnaire *gauche, NoeudDictionnaire *noeud, NoeudDictionnaire *droite)
+    {
+        if (_hauteur(gauche) > _hauteur(droite) + 1)
+        {
+            gauche->droite = _joint(gauche->droite, noeud, droite);
+            _equilibreAVL(gauche);
+            return gauche;
+        }
+        if (_hauteur(droite) > _hauteur(gauche) + 1)
+        {
+            droite->gauche = _joint(gauche, noeud, droite->gauche);
+            _equilibreAVL(droite);
+            return droite;
+        }
+        noeud->gauche = gauche;
+        noeud->droite = droite;
+        _equilibreAVL(noeud);
+        return noeud;
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_joint2(NoeudDictionnaire *gauche, NoeudDictionnaire *droite)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour joindre deux arbres AVL sans noeud du milieu
+     * \param[in] gauche Un arbre AVL dont tous les mots précèdent ceux de droite
+     * \param[in] droite Un arbre AVL
+     * \return La racine de l'arbre AVL joint
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_joint2(NoeudDictionnaire *gauche, NoeudDictionnaire *droite)
+    {
+        if (gauche == nullptr) return droite;
+        if (droite == nullptr) return gauche;
+        NoeudDictionnaire *min = _detacheMin(droite);
+        return _joint(gauche, min, droite);
+    }
+
+    /**
+     * \fn void Dictionnaire::_separe(NoeudDictionnaire *arbre, const std::string &mot, NoeudDictionnaire * &gauche, NoeudDictionnaire * &trouve, NoeudDictionnaire * &droite)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour séparer un arbre AVL autour d'un mot, en O(log n)
+     * \param[in] arbre L'arbre à séparer. Ses noeuds sont redistribués
+     * \param[in] mot Le mot autour duquel séparer
+     * \param[out] gauche L'arbre AVL des mots qui précèdent mot
+     * \param[out] trouve Le noeud de mot (sans enfants), ou nullptr s'il n'était pas dans l'arbre
+     * \param[out] droite L'arbre AVL des mots qui suivent mot
+     */
+    void Dictionnaire::_separe(NoeudDictionnaire *arbre, const std::string &mot, NoeudDictionnaire * &gauche, NoeudDictionnaire * &trouve, NoeudDictionnaire * &droite)
+    {
+        if (arbre == nullptr)
+        {
+            gauche = trouve = droite = nullptr;
+        }
+        else if (mot < arbre->mot)
         {
-            parent = temp;
-            temp = temp->gauche;
+            _separe(arbre->gauche, mot, gauche, trouve, droite);
+            droite = _joint(droite, arbre, arbre->droite);
         }
-        arbre->mot = temp->mot; // On remplace le mot par le plus petit mot de l'arbre droit
+        else if (mot > arbre->mot)
+        {
+            _separe(arbre->droite, mot, gauche, trouve, droite);
+            gauche = _joint(arbre->gauche, arbre, gauche);
+        }
+        else
+        {
+            gauche = arbre->gauche;
+            droite = arbre->droite;
+            trouve = arbre;
+            trouve->gauche = trouve->droite = nullptr;
+            trouve->hauteur = 0;
+        }
+    }
+
+    /**
+     * \fn unsigned int Dictionnaire::_niveauxParalleles()
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour choisir combien de niveaux de récursion se parallélisent
+     * \return Le plus petit k tel que 2^k atteint le nombre de coeurs (0 sur un seul coeur : tout est séquentiel)
+     */
+    unsigned int Dictionnaire::_niveauxParalleles()
+    {
+        unsigned int niveaux = 0;
+        while ((1u << niveaux) < std::thread::hardware_concurrency()) niveaux++;
+        return niveaux;
+    }
 
-        // On supprime le noeud (on a réduit au cas simple)
-        if (temp == parent->gauche) _supprimeMot(parent->gauche, temp->mot);
-        else _supprimeMot(parent->droite, temp->mot);
+    /**
+     * \fn void Dictionnaire::_appelsRecursifs(bool parallele, Gauche gauche, Droite droite)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour faire les deux appels récursifs, en parallèle ou non
+     * \param[in] parallele Si vrai, gauche est exécutée dans un autre thread pendant que le thread appelant exécute droite
+     * \param[in] gauche L'appel sur la moitié gauche
+     * \param[in] droite L'appel sur la moitié droite
+     * \pre Les deux appels touchent des noeuds disjoints et ne modifient aucun membre partagé (dont cpt)
+     */
+    template <typename Gauche, typename Droite>
+    void Dictionnaire::_appelsRecursifs(bool parallele, Gauche gauche, Droite droite)
+    {
+        if (!parallele)
+        {
+            gauche();
+            droite();
+            return;
+        }
+        std::future<void> tache = std::async(std::launch::async, gauche);
+        droite();
+        tache.get();
     }
 
     /**
-     * \fn void Dictionnaire::_accedeMot(NoeudDictionnaire * &arbre, const std::string &data) const
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_union(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation)
+     * \brief Méthode auxiliaire à fusionne pour ajouter à un sous-arbre les mots d'un sous-arbre d'un autre dictionnaire
+     * \param[in] arbre Le sous-arbre de ce dictionnaire. Ses noeuds sont réutilisés
+     * \param[in] autre Le sous-arbre de l'autre dictionnaire. Il n'est pas modifié
+     * \param[in] niveauxParalleles Le nombre de niveaux de récursion qui peuvent encore se faire en parallèle
+     * \param[out] variation Augmentée du nombre de mots ajoutés
+     * \return La racine de l'arbre AVL résultant
+     * \post En O(m log(n/m + 1)). Les deux appels récursifs sont indépendants : ils se font en parallèle
+     *       quand autre est assez haut, chacun comptant ses mots à part
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_union(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre,
+                                                          unsigned int niveauxParalleles, int &variation)
+    {
+        if (autre == nullptr) return arbre;
+        if (arbre == nullptr) return _copie(autre, variation);
+
+        NoeudDictionnaire *gauche, *trouve, *droite;
+        _separe(arbre, autre->mot, gauche, trouve, droite);
+        if (trouve == nullptr)
+        {
+            trouve = new NoeudDictionnaire(autre->mot, autre->traductions);
+            variation++;
+        }
+        else _fusionneTraductions(trouve, autre);
+
+        bool parallele = niveauxParalleles > 0 && autre->hauteur >= HAUTEUR_PARALLELE;
+        unsigned int niveaux = parallele ? niveauxParalleles - 1 : niveauxParalleles;
+        int variationGauche = 0, variationDroite = 0;
+        _appelsRecursifs(parallele,
+                         [&]() { gauche = _union(gauche, autre->gauche, niveaux, variationGauche); },
+                         [&]() { droite = _union(droite, autre->droite, niveaux, variationDroite); });
+        variation += variationGauche + variationDroite;
+        return _joint(gauche, trouve, droite);
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_intersection(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation)
+     * \brief Méthode auxiliaire à intersecte pour ne garder d'un sous-arbre que les mots d'un sous-arbre d'un autre dictionnaire
+     * \param[in] arbre Le sous-arbre de ce dictionnaire. Les noeuds retirés sont détruits
+     * \param[in] autre Le sous-arbre de l'autre dictionnaire. Il n'est pas modifié
+     * \param[in] niveauxParalleles Le nombre de niveaux de récursion qui peuvent encore se faire en parallèle
+     * \param[out] variation Diminuée du nombre de mots retirés
+     * \return La racine de l'arbre AVL résultant
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_intersection(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre,
+                                                                 unsigned int niveauxParalleles, int &variation)
+    {
+        if (arbre == nullptr) return nullptr;
+        if (autre == nullptr)
+        {
+            variation -= _detruitSousArbre(arbre);
+            return nullptr;
+        }
+
+        NoeudDictionnaire *gauche, *trouve, *droite;
+        _separe(arbre, autre->mot, gauche, trouve, droite);
+
+        bool parallele = niveauxParalleles > 0 && autre->hauteur >= HAUTEUR_PARALLELE;
+        unsigned int niveaux = parallele ? niveauxParalleles - 1 : niveauxParalleles;
+        int variationGauche = 0, variationDroite = 0;
+        _appelsRecursifs(parallele,
+                         [&]() { gauche = _intersection(gauche, autre->gauche, niveaux, variationGauche); },
+                         [&]() { droite = _intersection(droite, autre->droite, niveaux, variationDroite); });
+        variation += variationGauche + variationDroite;
+        if (trouve == nullptr) return _joint2(gauche, droite);
+
+        _fusionneTraductions(trouve, autre);
+        return _joint(gauche, trouve, droite);
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_difference(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation)
+     * \brief Méthode auxiliaire à soustrait pour retirer d'un sous-arbre les mots d'un sous-arbre d'un autre dictionnaire
+     * \param[in] arbre Le sous-arbre de ce dictionnaire. Les noeuds retirés sont détruits
+     * \param[in] autre Le sous-arbre de l'autre dictionnaire. Il n'est pas modifié
+     * \param[in] niveauxParalleles Le nombre de niveaux de récursion qui peuvent encore se faire en parallèle
+     * \param[out] variation Diminuée du nombre de mots retirés
+     * \return La racine de l'arbre AVL résultant
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_difference(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre,
+                                                               unsigned int niveauxParalleles, int &variation)
+    {
+        if (arbre == nullptr || autre == nullptr) return arbre;
+
+        NoeudDictionnaire *gauche, *trouve, *droite;
+        _separe(arbre, autre->mot, gauche, trouve, droite);
+        variation -= _detruitSousArbre(trouve);
+
+        bool parallele = niveauxParalleles > 0 && autre->hauteur >= HAUTEUR_PARALLELE;
+        unsigned int niveaux = parallele ? niveauxParalleles - 1 : niveauxParalleles;
+        int variationGauche = 0, variationDroite = 0;
+        _appelsRecursifs(parallele,
+                         [&]() { gauche = _difference(gauche, autre->gauche, niveaux, variationGauche); },
+                         [&]() { droite = _difference(droite, autre->droite, niveaux, variationDroite); });
+        variation += variationGauche + variationDroite;
+        return _joint2(gauche, droite);
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_differenceMots(NoeudDictionnaire *arbre, const std::vector<std::string> &mots, std::size_t debut, std::size_t fin, unsigned int niveauxParalleles, int &variation)
+     * \brief Méthode auxiliaire à supprimeMots pour retirer d'un sous-arbre une plage de mots triés
+     * \param[in] arbre Le sous-arbre. Les noeuds retirés sont détruits
+     * \param[in] mots Les mots à retirer, triés et sans doublons
+     * \param[in] debut L'indice du premier mot de la plage
+     * \param[in] fin L'indice suivant le dernier mot de la plage
+     * \param[in] niveauxParalleles Le nombre de niveaux de récursion qui peuvent encore se faire en parallèle
+     * \param[out] variation Diminuée du nombre de mots retirés
+     * \return La racine de l'arbre AVL résultant
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_differenceMots(NoeudDictionnaire *arbre, const std::vector<std::string> &mots,
+                                                                   std::size_t debut, std::size_t fin,
+                                                                   unsigned int niveauxParalleles, int &variation)
+    {
+        if (arbre == nullptr || debut >= fin) return arbre;
+
+        // On sépare autour du mot du milieu de la plage, comme si les mots formaient un arbre équilibré
+        std::size_t milieu = debut + (fin - debut) / 2;
+        NoeudDictionnaire *gauche, *trouve, *droite;
+        _separe(arbre, mots[milieu], gauche, trouve, droite);
+        variation -= _detruitSousArbre(trouve);
+
+        bool parallele = niveauxParalleles > 0 && fin - debut >= (1u << HAUTEUR_PARALLELE);
+        unsigned int niveaux = parallele ? niveauxParalleles - 1 : niveauxParalleles;
+        int variationGauche = 0, variationDroite = 0;
+        _appelsRecursifs(parallele,
+                         [&]() { gauche = _differenceMots(gauche, mots, debut, milieu, niveaux, variationGauche); },
+                         [&]() { droite = _differenceMots(droite, mots, milieu + 1, fin, niveaux, variationDroite); });
+        variation += variationGauche + variationDroite;
+        return _joint2(gauche, droite);
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_copie(const NoeudDictionnaire *autre, int &variation)
+     * \brief Méthode auxiliaire à fusionne pour copier un sous-arbre d'un autre dictionnaire
+     * \param[in] autre Le sous-arbre à copier
+     * \param[out] variation Augmentée du nombre de noeuds copiés
+     * \return La racine de la copie, de même forme et de mêmes hauteurs
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_copie(const NoeudDictionnaire *autre, int &variation)
+    {
+        if (autre == nullptr) return nullptr;
+        NoeudDictionnaire *noeud = new NoeudDictionnaire(autre->mot, autre->traductions);
+        variation++;
+        noeud->gauche = _copie(autre->gauche, variation);
+        noeud->droite = _copie(autre->droite, variation);
+        noeud->hauteur = autre->hauteur;
+        return noeud;
+    }
+
+    /**
+     * \fn int Dictionnaire::_detruitSousArbre(NoeudDictionnaire *arbre)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour détruire un sous-arbre sans toucher à cpt
+     * \param[in] arbre Le sous-arbre à détruire
+     * \return Le nombre de noeuds détruits
+     */
+    int Dictionnaire::_detruitSousArbre(NoeudDictionnaire *arbre)
+    {
+        if (arbre == nullptr) return 0;
+        int nombre = 1 + _detruitSousArbre(arbre->gauche) + _detruitSousArbre(arbre->droite);
+        delete arbre;
+        return nombre;
+    }
+
+    /**
+     * \fn void Dictionnaire::_fusionneTraductions(NoeudDictionnaire *noeud, const NoeudDictionnaire *autre)
+     * \brief Méthode auxiliaire aux opérations ensemblistes pour ajouter à un noeud les traductions d'un noeud du même mot
+     * \param[in] noeud Le noeud qui reçoit les traductions
+     * \param[in] autre Le noeud de l'autre dictionnaire
+     * \post Les traductions de autre absentes de noeud sont ajoutées à la suite, dans leur ordre
+     */
+    void Dictionnaire::_fusionneTraductions(NoeudDictionnaire *noeud, const NoeudDictionnaire *autre)
+    {
+        for (std::size_t i = 0; i < autre->traductions.size(); i++)
+        {
+            if (!_traductionEstPresente(noeud, autre->traductions[i])) noeud->traductions.push_back(autre->traductions[i]);
+        }
+    }
+
+    /**
+     * \fn void Dictionnaire::_majIndexInverse()
+     * \brief Méthode auxiliaire à l'index inverse pour le reconstruire s'il n'est plus à jour
+     * \post L'index contient une entrée par clé de chaque traduction, triée par clé puis par mot anglais
+     * \post Plusieurs lecteurs peuvent l'appeler en même temps : un seul reconstruit l'index, les autres l'attendent
+     * \exception logic_error Si l'index inverse n'est pas activé
+     */
+    void Dictionnaire::_majIndexInverse()
+    {
+        if (!indexInverseActif) throw std::logic_error("L'index inverse n'est pas activé");
+        if (indexInverseAJour.load(std::memory_order_acquire)) return;
+
+        std::lock_guard<std::mutex> verrou(verrouIndexInverse);
+        if (indexInverseAJour.load(std::memory_order_relaxed)) return; // Reconstruit par un autre lecteur
+
+        indexInverse.clear();
+        _remplisIndexInverse(racine);
+        // Le parcours est en ordre des mots anglais : le tri stable garde cet ordre pour une même clé
+        std::stable_sort(indexInverse.begin(), indexInverse.end(),
+                         [](const EntreeInverse &a, const EntreeInverse &b) { return a.traduction < b.traduction; });
+        indexInverseAJour.store(true, std::memory_order_release);
+    }
+
+    /**
+     * \fn void Dictionnaire::_remplisIndexInverse(NoeudDictionnaire * const &arbre)
+     * \brief Méthode auxiliaire à _majIndexInverse pour ajouter à l'index les traductions d'un sous-arbre (parcours infixe)
+     * \param[in] arbre Le sous-arbre
+     */
+    void Dictionnaire::_remplisIndexInverse(NoeudDictionnaire * const &arbre)
+    {
+        if (arbre == nullptr) return;
+        _remplisIndexInverse(arbre->gauche);
+        for (std::size_t i = 0; i < arbre->traductions.size(); i++) _ajouteClesInverses(arbre->traductions[i], arbre);
+        _remplisIndexInverse(arbre->droite);
+    }
+
+    /**
+     * \fn void Dictionnaire::_ajouteClesInverses(std::string_view traduction, NoeudDictionnaire *noeud)
+     * \brief Méthode auxiliaire à _remplisIndexInverse pour ajouter à l'index les clés d'une traduction
+     * \param[in] traduction La traduction (une chaîne du noeud)
+     * \param[in] noeud Le noeud du mot anglais
+     * \post La traduction complète, sa forme sans article et chacune de ses variantes séparées par '/'
+     *       (sans article, sauf les simples terminaisons) sont des clés. Une même clé n'est ajoutée qu'une fois
+     * \post Les espaces autour des clés sont ignorés. Les clés vides sont ignorées
+     */
+    void Dictionnaire::_ajouteClesInverses(std::string_view traduction, NoeudDictionnaire *noeud)
+    {
+        std::vector<std::string_view> cles;
+        std::string_view complete = _sansEspaces(traduction);
+        if (complete.empty()) return;
+        cles.push_back(complete);
+        cles.push_back(_sansArticle(complete));
+
+        if (complete.find('/') != std::string_view::npos)
+        {
+            std::size_t debut = 0;
+            while (debut <= complete.size())
+            {
+                std::size_t fin = complete.find('/', debut);
+                if (fin == std::string_view::npos) fin = complete.size();
+                std::string_view variante = _sansArticle(_sansEspaces(complete.substr(debut, fin - debut)));
+                // "chien/ne", "pacificateur / -trice" : la variante n'est qu'une terminaison
+                if (variante.size() >= 4 && variante[0] != '-') cles.push_back(variante);
+                debut = fin + 1;
+            }
+        }
+
+        for (std::size_t i = 0; i < cles.size(); i++)
+        {
+            if (cles[i].empty() || std::find(cles.begin(), cles.begin() + i, cles[i]) != cles.begin() + i) continue;
+            EntreeInverse entree = { cles[i], noeud };
+            indexInverse.push_back(entree);
+        }
+    }
+
+    /**
+     * \fn std::string_view Dictionnaire::_sansEspaces(std::string_view texte)
+     * \brief Méthode auxiliaire à l'index inverse pour retirer les espaces autour d'un texte
+     * \param[in] texte Le texte
+     * \return Le texte sans espaces, tabulations ni retours de chariot autour (vide s'il n'a que ça)
+     */
+    std::string_view Dictionnaire::_sansEspaces(std::string_view texte)
+    {
+        std::size_t debut = texte.find_first_not_of(" \t\r");
+        if (debut == std::string_view::npos) return std::string_view();
+        return texte.substr(debut, texte.find_last_not_of(" \t\r") - debut + 1);
+    }
+
+    /**
+     * \fn std::string_view Dictionnaire::_sansArticle(std::string_view texte)
+     * \brief Méthode auxiliaire à l'index inverse pour retirer l'article au début d'un texte
+     * \param[in] texte Le texte, sans espaces autour
+     * \return Le texte sans son article initial (le, la, les, l', un, une, des, du), ou le texte lui-même
+     *         s'il n'a pas d'article ou n'est qu'un article
+     */
+    std::string_view Dictionnaire::_sansArticle(std::string_view texte)
+    {
+        static const std::string_view articles[] = { "le ", "la ", "les ", "l'", "un ", "une ", "des ", "du " };
+        for (std::size_t i = 0; i < sizeof(articles) / sizeof(articles[0]); i++)
+        {
+            if (texte.size() > articles[i].size() && texte.substr(0, articles[i].size()) == articles[i])
+            {
+                return _sansEspaces(texte.substr(articles[i].size()));
+            }
+        }
+        return texte;
+    }
+
+    /**
+     * \fn Dictionnaire::NoeudDictionnaire* Dictionnaire::_accedeMotCache(std::string_view mot)
+     * \brief Méthode privée pour accéder à un mot en passant d'abord par le cache des mots fréquents
+     * \param[in] mot Le mot à chercher
+     * \return Le noeud contenant le mot, nullptr si le mot n'est pas présent
+     * \post L'accès est compté. Un mot trouvé dans l'arbre est proposé au cache
+     * \post Si le cache est désactivé (activeCache), on cherche seulement dans l'arbre
+     * \post Peut être appelée par plusieurs lecteurs en même temps, tant que l'arbre n'est pas modifié
+     */
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_accedeMotCache(std::string_view mot)
+    {
+        if (!cacheActif) return _accedeMot(racine, mot);
+        std::size_t hachage = std::hash<std::string_view>()(mot);
+        NoeudDictionnaire *noeud = cacheMots.cherche(mot, hachage);
+        if (noeud != nullptr) return noeud;
+
+        noeud = _accedeMot(racine, mot);
+        if (noeud != nullptr) cacheMots.propose(noeud, hachage);
+        return noeud;
+    }
+
+    /**
+     * \fn void Dictionnaire::_accedeMot(NoeudDictionnaire * &arbre, std::string_view data) const
      * \brief Méthode privée pour accéder à un mot. Est utilisée pour savoir si un mot est présent dans le dictionnaire
      * \param[in] arbre Le sous-arbre dans lequel chercher le mot
      * \param[in] data Le mot à chercher
      * \return Le noeud contenant le mot, nullptr si le mot n'est pas présent
      */
-    Dictionnaire::NoeudDictionnaire* Dictionnaire::_accedeMot(NoeudDictionnaire * &arbre, const std::string &data) const
+    Dictionnaire::NoeudDictionnaire* Dictionnaire::_accedeMot(NoeudDictionnaire * &arbre, std::string_view data) const
     {
         if (arbre == nullptr)
         {
@@ -428,18 +1502,19 @@ namespace TP3
     }
 
     /**
-     * \fn void Dictionnaire::_suggereCorrections(NoeudDictionnaire* const &arbre, const std::string &motMalEcrit, std::vector<std::string> &suggestions)
+     * \fn void Dictionnaire::_suggereCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit, std::vector<std::string> &suggestions)
      * \brief Méthode auxiliaire de suggereCorrections pour chercher récursivement les mots similaires. Prend un vecteur de suggestions par référence pour le remplir
      * \param[in] arbre Le sous-arbre dans lequel chercher les mots
      * \param[in] motMalEcrit Le mot mal écrit
      * \param[in] suggestions Le vecteur de suggestions
      */
-    void Dictionnaire::_suggereCorrections(NoeudDictionnaire* const &arbre, const std::string &motMalEcrit, std::vector<std::string> &suggestions)
+    template <typename M>
+    void Dictionnaire::_suggereCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit, std::vector<std::string> &suggestions)
     {
         if (arbre == nullptr) return;
-        _suggereCorrections(arbre->gauche, motMalEcrit, suggestions);
-        if (similitude(motMalEcrit, arbre->mot) >= 0.6) suggestions.push_back(arbre->mot);
-        _suggereCorrections(arbre->droite, motMalEcrit, suggestions);
+        _suggereCorrections<M>(arbre->gauche, motMalEcrit, suggestions);
+        if (Metriques::similitude<M>(motMalEcrit, arbre->mot) >= M::SEUIL) suggestions.push_back(arbre->mot);
+        _suggereCorrections<M>(arbre->droite, motMalEcrit, suggestions);
         /* if (similitude(motMalEcrit, arbre->mot) >= 0.5)
         {
             auto position = std::upper_bound(suggestions.begin(), suggestions.end(), arbre->mot std::greater<int>());
@@ -448,6 +1523,40 @@ namespace TP3
         } */
     }
 
+    /**
+     * \fn void Dictionnaire::_candidatsCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit, std::vector<NoeudDictionnaire*> &candidats, std::vector<std::uint64_t> &ordre) const
+     * \brief Méthode auxiliaire de suggereCorrections avec budget pour lister les candidats en ordre alphabétique
+     * \param[in] arbre Le sous-arbre dans lequel chercher les candidats
+     * \param[in] motMalEcrit Le mot mal écrit
+     * \param[out] candidats Les noeuds candidats
+     * \param[out] ordre Pour chaque candidat : son rang (différence de longueur, puis préfixe commun, plus long = plus petit)
+     *             dans les 32 bits forts et sa position dans candidats dans les 32 bits faibles
+     * \post Un mot dont la différence de longueur d dépasse (1 - seuil) fois la plus grande longueur est écarté :
+     *       toutes les métriques comptent une opération complète par lettre insérée ou supprimée, la distance
+     *       est donc au moins d, et la similitude sous le seuil de M
+     */
+    template <typename M>
+    void Dictionnaire::_candidatsCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit,
+                                             std::vector<NoeudDictionnaire*> &candidats, std::vector<std::uint64_t> &ordre) const
+    {
+        if (arbre == nullptr) return;
+        _candidatsCorrections<M>(arbre->gauche, motMalEcrit, candidats, ordre);
+
+        const std::string &mot = arbre->mot;
+        std::size_t plusLong = std::max(mot.size(), motMalEcrit.size());
+        std::size_t difference = plusLong - std::min(mot.size(), motMalEcrit.size());
+        if (difference <= (1.0 - M::SEUIL) * plusLong + 1e-9)
+        {
+            std::size_t prefixe = 0;
+            while (prefixe < mot.size() && prefixe < motMalEcrit.size() && prefixe < 0xFFFF && mot[prefixe] == motMalEcrit[prefixe]) prefixe++;
+            std::uint64_t rang = (std::min<std::uint64_t>(difference, 0xFFFF) << 16) | (0xFFFF - prefixe);
+            ordre.push_back((rang << 32) | candidats.size());
+            candidats.push_back(arbre);
+        }
+
+        _candidatsCorrections<M>(arbre->droite, motMalEcrit, candidats, ordre);
+    }
+
     /**
      * \fn void Dictionnaire::_hauteur(NoeudDictionnaire * &arbre) const
      * \brief Méthode privée pour calculer la hauteur d'un sous-arbre
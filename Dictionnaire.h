@@ -12,10 +12,18 @@
 #define DICO_H_
 
 #include <iostream>
+#include <chrono>
+#include <atomic>
+#include <cstdint>
 #include <fstream> // pour les fichiers
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <queue>
+#include <utility>
+#include "CacheMotsFrequents.h"
+#include "Metriques.h"
 
 namespace TP3
 {
@@ -30,40 +38,123 @@ public:
 
 	//Constructeur de dictionnaire à partir d'un fichier
 	//Le fichier doit être ouvert au préalable
-	Dictionnaire(std::ifstream &fichier);
+	//Si avecIndexInverse est vrai, l'index français -> anglais est construit lors du même chargement
+	//Mémoire : au plus fort, le contenu du fichier (lu d'un coup) plus les paires (mot, traduction) extraites.
+	//Le contenu est libéré avant la fusion des blocs, qui déplace les chaînes sans les copier.
+	Dictionnaire(std::ifstream &fichier, bool avecIndexInverse = false);
+
+	//Analyser une ligne d'un fichier de dictionnaire au format IDP ("mot\tdéfinition")
+	//On retourne false si la ligne est un commentaire ou n'a pas de tabulation. Sinon, on retourne true
+	//avec le mot anglais et sa traduction nettoyée, comme lors du chargement.
+	static bool lisLigne(std::string_view ligneDico, std::string &motAnglais, std::string &motTraduit);
 
 	//Destructeur.
 	~Dictionnaire();
 
 	//Ajouter un mot au dictionnaire et l'une de ses traductions en équilibrant l'arbre AVL
 	void ajouteMot(const std ::string& motOriginal, const std ::string& motTraduit);
+	//Même chose, mais les chaînes sont déplacées dans le dictionnaire au lieu d'être copiées
+	void ajouteMot(std::string &&motOriginal, std::string &&motTraduit);
 
 	//Supprimer un mot et équilibrer l'arbre AVL
 	//Si le mot appartient au dictionnaire, on l'enlève et on équilibre. Sinon, on ne fait rien.
 	//Exception	logic_error si l'arbre est vide
 	//Exception	logic_error si le mot n'appartient pas au dictionnaire
-	void supprimeMot(const std ::string& motOriginal);
+	void supprimeMot(std::string_view motOriginal);
+
+	//Appliquer un fichier de modifications (delta) au dictionnaire en un seul lot, sans tout recharger
+	//Chaque ligne est "+\tmot\tdéfinition", "-\tmot\ttraduction" ou "-\tmot" ('#' pour un commentaire)
+	//Le fichier doit être ouvert au préalable
+	//Le lot est appliqué en place (noeuds modifiés et détruits) : comme pour les autres modifications, aucune
+	//lecture ne doit avoir lieu en même temps. Pour appliquer un lot pendant que d'autres threads lisent, utiliser
+	//DictionnaireReparti::appliqueDelta : le lot y est appliqué sous le verrou exclusif de tous les fragments,
+	//et ses lectures de plusieurs fragments les verrouillent tous, si bien qu'aucune ne voit un lot à moitié.
+	//Exception	logic_error si une ligne est mal formée (rien n'est alors appliqué)
+	void appliqueDelta(std::ifstream &fichier);
+
+	//Supprimer plusieurs mots d'un coup et équilibrer l'arbre AVL
+	//Les mots qui n'appartiennent pas au dictionnaire sont ignorés
+	void supprimeMots(const std::vector<std::string> &mots);
+
+	//Ajouter au dictionnaire tous les mots d'un autre dictionnaire (union)
+	//Quand un mot est dans les deux, ses traductions sont fusionnées
+	void fusionne(const Dictionnaire &autre);
+
+	//Ne garder que les mots qui sont aussi dans un autre dictionnaire (intersection)
+	//Les traductions des mots gardés sont fusionnées
+	void intersecte(const Dictionnaire &autre);
+
+	//Retirer du dictionnaire tous les mots d'un autre dictionnaire (différence)
+	void soustrait(const Dictionnaire &autre);
 
 	//Quantifier la similitude entre 2 mots (dans le dictionnaire ou pas)
 	//Ici, 1 représente le fait que les 2 mots sont identiques, 0 représente le fait que les 2 mots sont complètements différents
 	//On retourne une valeur entre 0 et 1 quantifiant la similarité entre les 2 mots donnés
 	//Vous pouvez utiliser par exemple la distance de Levenshtein, mais ce n'est pas obligatoire !
-	double similitude(const std::string& mot1, const std::string& mot2);
+	double similitude(std::string_view mot1, std::string_view mot2);
+
+	//Choisir la métrique de similitude (et son seuil) utilisée par similitude et les suggestions de correction
+	//LEVENSHTEIN par défaut. Voir Metriques.h
+	void choisitMetrique(Metrique nouvelleMetrique);
+
+	//Retourner la métrique de similitude utilisée
+	Metrique metriqueChoisie() const;
+
+	//Activer ou non le cache des mots fréquents devant l'arbre (actif par défaut, voir CacheMotsFrequents.h)
+	//Sans le cache, traduit et appartient cherchent toujours dans l'arbre. Sert surtout à mesurer le cache.
+	//Comme une modification, ne doit pas être appelée pendant une lecture
+	void activeCache(bool actif);
 
 
 	//Suggère des corrections pour le mot motMalEcrit sous forme d'une liste de mots, dans un vector, à partir du dictionnaire
 	//S'il y a suffisament de mots, on redonne 5 corrections possibles au mot donné. Sinon, on en donne le plus possible
 	//Exception	logic_error si le dictionnaire est vide
-	std::vector<std::string> suggereCorrections(const std ::string& motMalEcrit);
+	std::vector<std::string> suggereCorrections(std::string_view motMalEcrit);
+
+	//Suggère jusqu'à 5 corrections comme suggereCorrections, mais en bornant le travail (nombre d'appels à similitude)
+	//et le temps (0 : pas de limite). Les candidats les plus prometteurs (longueur proche, long préfixe commun) sont
+	//évalués en premier. On retourne les meilleures corrections trouvées, de la plus similaire à la moins similaire.
+	//estExhaustif indique si tous les candidats ont pu être évalués (le résultat est alors le vrai top 5)
+	std::vector<std::string> suggereCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations,
+	                                            std::chrono::microseconds delai, bool &estExhaustif);
 
 	//Trouver les traductions possibles d'un mot
 	//Si le mot appartient au dictionnaire, on retourne le vecteur des traductions du mot donné.
 	//Sinon, on retourne un vecteur vide
-	std::vector<std::string> traduit(const std ::string& mot);
+	std::vector<std::string> traduit(std::string_view mot);
 
 	//Vérifier si le mot donné appartient au dictionnaire
 	//On retourne true si le mot est dans le dictionnaire. Sinon, on retourne false.
-	bool appartient(const std::string &data);
+	bool appartient(std::string_view data);
+
+	//Activer l'index inverse (français -> anglais). Il est construit immédiatement,
+	//puis reconstruit au besoin après une modification du dictionnaire.
+	//Clés de l'index, pour chaque traduction (sans espaces autour) :
+	//  - la traduction complète ("le chat", "chien/ne") ;
+	//  - la traduction sans article initial (le, la, les, l', un, une, des, du) : "chat" ;
+	//  - chaque variante séparée par '/', sans article ("avorteur/ avorteuse" donne "avorteur" et "avorteuse").
+	//    Une variante qui n'est qu'une terminaison (commence par '-' ou a moins de 4 caractères,
+	//    comme "ne" dans "chien/ne") n'est pas une clé : seul "chien" l'est.
+	//Les requêtes inverses peuvent être faites par plusieurs lecteurs en même temps (la reconstruction
+	//après une modification est protégée), mais pas pendant une modification du dictionnaire.
+	//Coût : l'index n'est pas mis à jour mot à mot. Après toute modification (même un seul ajouteMot),
+	//la requête inverse suivante le reconstruit en entier (parcours de l'arbre et tri, O(t log t) pour t traductions).
+	//Alterner modifications et requêtes inverses coûte donc une reconstruction complète à chaque fois :
+	//mieux vaut regrouper les modifications (appliqueDelta, ou plusieurs ajouteMot de suite) avant d'interroger l'index.
+	void activeIndexInverse();
+
+	//Trouver les mots anglais dont le mot français donné est une traduction (voir les clés ci-dessus)
+	//On retourne un vecteur vide si aucun mot anglais n'a cette traduction
+	//Exception	logic_error si l'index inverse n'est pas activé
+	std::vector<std::string> traduitInverse(std::string_view motFrancais);
+
+	//Vérifier si le mot français donné est la traduction d'au moins un mot du dictionnaire
+	//Exception	logic_error si l'index inverse n'est pas activé
+	bool appartientInverse(std::string_view motFrancais);
+
+	//Suggère jusqu'à 5 corrections parmi les traductions françaises, comme suggereCorrections
+	//Exception	logic_error si l'index inverse n'est pas activé
+	std::vector<std::string> suggereCorrectionsInverse(std::string_view motMalEcrit);
 
 	//Vérifier si le dictionnaire est vide
 	bool estVide() const;
@@ -120,6 +211,12 @@ public:
 
 private:
 
+	// Les dictionnaires compact et persistant se construisent en parcourant directement les noeuds
+	friend class DictionnaireCompact;
+	friend class DictionnairePersistant;
+	// Le dictionnaire réparti valide un delta une seule fois, puis en applique une partie à chaque fragment
+	friend class DictionnaireReparti;
+
 	// Classe interne représentant un noeud dans l'arbre AVL constituant le dictionnaire de traduction.
 	class NoeudDictionnaire
 	{
@@ -136,39 +233,148 @@ private:
 	    int hauteur;				// La hauteur de ce noeud (afin de maintenir l'équilibre de l'arbre AVL)
 
 		// Vous pouvez ajouter ici un contructeur de NoeudDictionnaire
-		NoeudDictionnaire(const std::string &mot, const std::string &traduction)
+		// Les chaînes sont prises par valeur puis déplacées : un appelant qui passe une rvalue ne paie aucune copie
+		NoeudDictionnaire(std::string mot, std::string traduction)
+		{
+			this->mot = std::move(mot);
+			this->traductions.push_back(std::move(traduction));
+			this->gauche = 0;
+			this->droite = 0;
+			this->hauteur = 0;
+		}
+
+		// Constructeur d'un noeud avec toutes ses traductions (copie d'un noeud d'un autre dictionnaire)
+		NoeudDictionnaire(std::string mot, std::vector<std::string> traductions)
 		{
-			this->mot = mot;
-			this->traductions.push_back(traduction);
+			this->mot = std::move(mot);
+			this->traductions = std::move(traductions);
 			this->gauche = 0;
 			this->droite = 0;
 			this->hauteur = 0;
 		}
 	};
     
+	// Une opération lue dans un fichier delta (voir appliqueDelta)
+	struct OperationDelta
+	{
+		bool ajout;				// true pour '+', false pour '-'
+		std::string mot;			// Le mot (en anglais) visé
+		std::string traduction;			// La traduction visée (vide pour retirer tout le mot)
+	};
+
+	// Une entrée de l'index inverse : une clé (vue sur une partie de la chaîne d'une traduction du noeud,
+	// voir activeIndexInverse) et le noeud du mot anglais qu'elle traduit. Aucune chaîne n'est copiée.
+	struct EntreeInverse
+	{
+		std::string_view traduction;
+		NoeudDictionnaire *noeud;
+	};
+
 	NoeudDictionnaire * racine;		// La racine de l'arbre des mots
     
 	int cpt;				// Le nombre de mots dans le dictionnaire
+
+	bool indexInverseActif;			// L'index inverse (français -> anglais) est-il demandé ?
+	std::atomic<bool> indexInverseAJour;	// L'index inverse reflète-t-il l'arbre actuel ?
+	std::mutex verrouIndexInverse;		// Sérialise la reconstruction de l'index entre lecteurs
+	std::vector<EntreeInverse> indexInverse;	// Les entrées, triées par clé puis par mot anglais
+
+	Metrique metrique;			// La métrique de similitude des suggestions
+
+	CacheMotsFrequents<NoeudDictionnaire> cacheMots;	// Les noeuds des mots les plus demandés (vidé quand un noeud peut être détruit)
+	bool cacheActif;			// traduit et appartient passent-ils par cacheMots ?
 	
 	//Vous pouvez ajouter autant de méthodes privées que vous voulez
 	
 	// Méthode auxiliaire au destructeur pour détruire le dictionnaire
 	void _detruireDictionnaire(NoeudDictionnaire * &arbre);
 
+	// Méthode auxiliaire au chargement pour extraire le mot français d'une définition au format IDP
+	static std::string _extraitTraduction(std::string motTraduit);
+
+	// Méthodes auxiliaires au chargement en parallèle d'un fichier
+	static std::vector<std::pair<std::string, std::string> > _lisBloc(const std::string &contenu, std::size_t debut, std::size_t fin);
+	static bool _comparePaires(const std::pair<std::string, std::string> &a, const std::pair<std::string, std::string> &b);
+	static std::vector<std::pair<std::string, std::string> > _fusionneBlocs(std::vector<std::pair<std::string, std::string> > &premier, std::vector<std::pair<std::string, std::string> > &second);
+	void _construitDepuisPaires(std::vector<std::pair<std::string, std::string> > &paires);
+
+	// Méthodes auxiliaires à appliqueDelta
+	static std::vector<OperationDelta> _lisDelta(std::istream &fichier);
+	void _appliqueOperations(std::vector<OperationDelta> &operations);
+	void _appliqueOperation(const OperationDelta &operation);
+	void _aplatit(NoeudDictionnaire * const &arbre, std::vector<NoeudDictionnaire*> &noeuds) const;
+	NoeudDictionnaire* _construitEquilibre(std::vector<NoeudDictionnaire*> &noeuds, std::size_t debut, std::size_t fin);
+
 	// Méthodes auxiliaires à ajouteMot pour ajouter un mot et sa traduction au dictionnaire
-	bool _ajouteMot(NoeudDictionnaire * &arbre, const std::string &motOriginal, const std::string &motTraduit);
-	bool _traductionEstPresente(NoeudDictionnaire * &noeud, const std::string &motTraduit) const;
+	// (Mot et Traduction : const std::string& pour copier, std::string pour déplacer dans le noeud)
+	template <typename Mot, typename Traduction>
+	bool _ajouteMot(NoeudDictionnaire * &arbre, Mot &&motOriginal, Traduction &&motTraduit);
+	bool _traductionEstPresente(NoeudDictionnaire * &noeud, std::string_view motTraduit) const;
 	
 	// Méthodes auxiliaires à supprimeMot pour supprimer un mot du dictionnaire
-	void _supprimeMot(NoeudDictionnaire * &arbre, const std::string &motOriginal);
+	void _supprimeMot(NoeudDictionnaire * &arbre, std::string_view motOriginal);
 	void _enleveMinDroite(NoeudDictionnaire * &arbre);
+	NoeudDictionnaire* _detacheMin(NoeudDictionnaire * &arbre);
 	
+	// Méthodes auxiliaires aux opérations ensemblistes (fusionne, intersecte, soustrait, supprimeMots),
+	// basées sur la séparation et la jonction d'arbres AVL. Les méthodes récursives ne touchent pas à cpt :
+	// chacune retourne sa variation du nombre de mots, si bien que leurs deux appels récursifs peuvent
+	// se faire en parallèle sur les grands sous-arbres
+	NoeudDictionnaire* _joint(NoeudDictionnaire *gauche, NoeudDictionnaire *noeud, NoeudDictionnaire *droite);
+	NoeudDictionnaire* _joint2(NoeudDictionnaire *gauche, NoeudDictionnaire *droite);
+	void _separe(NoeudDictionnaire *arbre, const std::string &mot, NoeudDictionnaire * &gauche, NoeudDictionnaire * &trouve, NoeudDictionnaire * &droite);
+	static unsigned int _niveauxParalleles();
+	template <typename Gauche, typename Droite>
+	void _appelsRecursifs(bool parallele, Gauche gauche, Droite droite);
+	NoeudDictionnaire* _union(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation);
+	NoeudDictionnaire* _intersection(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation);
+	NoeudDictionnaire* _difference(NoeudDictionnaire *arbre, const NoeudDictionnaire *autre, unsigned int niveauxParalleles, int &variation);
+	NoeudDictionnaire* _differenceMots(NoeudDictionnaire *arbre, const std::vector<std::string> &mots, std::size_t debut, std::size_t fin,
+	                                   unsigned int niveauxParalleles, int &variation);
+	NoeudDictionnaire* _copie(const NoeudDictionnaire *autre, int &variation);
+	int _detruitSousArbre(NoeudDictionnaire *arbre);
+	void _fusionneTraductions(NoeudDictionnaire *noeud, const NoeudDictionnaire *autre);
+
+	// Méthodes auxiliaires à l'index inverse
+	void _majIndexInverse();
+	void _remplisIndexInverse(NoeudDictionnaire * const &arbre);
+	void _ajouteClesInverses(std::string_view traduction, NoeudDictionnaire *noeud);
+	static std::string_view _sansEspaces(std::string_view texte);
+	static std::string_view _sansArticle(std::string_view texte);
+
 	// Méthode privée pour accéder à un mot. Est utilisée pour savoir si un mot est présent dans le dictionnaire
 	// Et à trouver les traductions d'un mot
-	NoeudDictionnaire* _accedeMot(NoeudDictionnaire * &arbre, const std::string &data) const;
+	NoeudDictionnaire* _accedeMot(NoeudDictionnaire * &arbre, std::string_view data) const;
+	// Même chose, en passant d'abord par le cache des mots fréquents
+	NoeudDictionnaire* _accedeMotCache(std::string_view mot);
+
+	// Appeler fonction avec la politique (voir Metriques.h) de la métrique choisie. Le choix se fait une fois
+	// par requête : chaque méthode de suggestion est instanciée pour chaque métrique, avec ses coûts en constantes
+	template <typename Fonction>
+	void _avecMetrique(Fonction fonction)
+	{
+		switch (metrique)
+		{
+		case DAMERAU_LEVENSHTEIN:	fonction(Metriques::DamerauLevenshtein()); break;
+		case CLAVIER_QWERTY:		fonction(Metriques::ClavierQwerty()); break;
+		default:			fonction(Metriques::Levenshtein()); break;
+		}
+	}
 
 	// Méthode auxiliaire de suggereCorrections
-	void _suggereCorrections(NoeudDictionnaire* const &arbre, const std::string &motMalEcrit, std::vector<std::string> &suggestions);
+	template <typename M>
+	void _suggereCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit, std::vector<std::string> &suggestions);
+	// Méthodes auxiliaires de suggereCorrections avec budget : les candidats possibles et leur rang (plus petit = plus prometteur),
+	// puis l'évaluation des candidats dans cet ordre
+	template <typename M>
+	void _candidatsCorrections(NoeudDictionnaire* const &arbre, std::string_view motMalEcrit,
+	                           std::vector<NoeudDictionnaire*> &candidats, std::vector<std::uint64_t> &ordre) const;
+	template <typename M>
+	void _meilleuresCorrections(std::string_view motMalEcrit, unsigned int budgetEvaluations, std::chrono::microseconds delai,
+	                            std::chrono::steady_clock::time_point debut, bool &estExhaustif, std::vector<std::string> &suggestions);
+	// Méthode auxiliaire de suggereCorrectionsInverse
+	template <typename M>
+	void _suggereCorrectionsInverse(std::string_view motMalEcrit, std::vector<std::string> &suggestions);
 
 	// Méthode privée pour calculer la hauteur d'un noeud
 	int _hauteur(NoeudDictionnaire * &arbre) const;
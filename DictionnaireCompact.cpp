@@ -0,0 +1,243 @@
+/**
+ * \file DictionnaireCompact.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireCompact
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "DictionnaireCompact.h"
+
+namespace TP3
+{
+    const unsigned int DictionnaireCompact::TAILLE_BLOC;
+
+    /**
+     * \fn DictionnaireCompact::DictionnaireCompact(const Dictionnaire &dictionnaire)
+     * \brief Constructeur d'un dictionnaire compact à partir d'un dictionnaire
+     * \param[in] dictionnaire Le dictionnaire à copier. Il n'est pas modifié
+     * \post Le dictionnaire compact contient les mêmes mots et traductions, dans le même ordre
+     */
+    DictionnaireCompact::DictionnaireCompact(const Dictionnaire &dictionnaire) : cpt(0)
+    {
+        std::vector<Dictionnaire::NoeudDictionnaire*> noeuds;
+        noeuds.reserve(dictionnaire.taille());
+        dictionnaire._aplatit(dictionnaire.racine, noeuds);
+        cpt = noeuds.size();
+
+        for (std::size_t i = 0; i < noeuds.size(); i++)
+        {
+            const std::string &mot = noeuds[i]->mot;
+            if (i % TAILLE_BLOC == 0)
+            {
+                // Tête de bloc : le mot complet
+                debutsBlocs.push_back(mots.size());
+                debutsTraductions.push_back(traductions.size());
+                _ajouteEntier(mots, mot.size());
+                mots.insert(mots.end(), mot.begin(), mot.end());
+            }
+            else
+            {
+                // Les autres : longueur du préfixe commun avec le mot précédent, puis le suffixe
+                const std::string &precedent = noeuds[i - 1]->mot;
+                std::size_t commun = 0;
+                while (commun < mot.size() && commun < precedent.size() && mot[commun] == precedent[commun]) commun++;
+                _ajouteEntier(mots, commun);
+                _ajouteEntier(mots, mot.size() - commun);
+                mots.insert(mots.end(), mot.begin() + commun, mot.end());
+            }
+
+            const std::vector<std::string> &traductionsMot = noeuds[i]->traductions;
+            _ajouteEntier(traductions, traductionsMot.size());
+            for (std::size_t t = 0; t < traductionsMot.size(); t++)
+            {
+                _ajouteEntier(traductions, traductionsMot[t].size());
+                traductions.insert(traductions.end(), traductionsMot[t].begin(), traductionsMot[t].end());
+            }
+        }
+
+        mots.shrink_to_fit();
+        traductions.shrink_to_fit();
+        debutsBlocs.shrink_to_fit();
+        debutsTraductions.shrink_to_fit();
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireCompact::traduit(std::string_view mot) const
+     * \brief Retourne les traductions possibles d'un mot
+     * \param[in] mot Le mot à traduire
+     * \return Les traductions du mot, ou un vecteur vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireCompact::traduit(std::string_view mot) const
+    {
+        std::vector<std::string> resultat;
+        std::size_t bloc, rang;
+        if (!_cherche(mot, bloc, rang)) return resultat;
+
+        // On saute les traductions des mots qui précèdent dans le bloc
+        std::size_t position = debutsTraductions[bloc];
+        for (std::size_t r = 0; r < rang; r++)
+        {
+            std::size_t nb = _lisEntier(traductions, position);
+            for (std::size_t t = 0; t < nb; t++) position += _lisEntier(traductions, position);
+        }
+
+        std::size_t nb = _lisEntier(traductions, position);
+        resultat.reserve(nb);
+        for (std::size_t t = 0; t < nb; t++)
+        {
+            std::size_t longueur = _lisEntier(traductions, position);
+            resultat.push_back(std::string(reinterpret_cast<const char*>(traductions.data() + position), longueur));
+            position += longueur;
+        }
+        return resultat;
+    }
+
+    /**
+     * \fn bool DictionnaireCompact::appartient(std::string_view mot) const
+     * \brief Vérifie si un mot appartient au dictionnaire
+     * \param[in] mot Le mot à vérifier
+     * \return true si le mot appartient au dictionnaire, false sinon
+     */
+    bool DictionnaireCompact::appartient(std::string_view mot) const
+    {
+        std::size_t bloc, rang;
+        return _cherche(mot, bloc, rang);
+    }
+
+    /**
+     * \fn bool DictionnaireCompact::estVide() const
+     * \brief Vérifie si le dictionnaire est vide
+     * \return true si le dictionnaire est vide, false sinon
+     */
+    bool DictionnaireCompact::estVide() const
+    {
+        return cpt == 0;
+    }
+
+    /**
+     * \fn unsigned int DictionnaireCompact::taille() const
+     * \brief Retourne le nombre de mots dans le dictionnaire
+     * \return Le nombre de mots dans le dictionnaire
+     */
+    unsigned int DictionnaireCompact::taille() const
+    {
+        return cpt;
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::memoireUtilisee() const
+     * \brief Retourne le nombre d'octets occupés par les tampons du dictionnaire
+     * \return La somme des capacités des tampons, en octets
+     */
+    std::size_t DictionnaireCompact::memoireUtilisee() const
+    {
+        return mots.capacity() + traductions.capacity()
+             + (debutsBlocs.capacity() + debutsTraductions.capacity()) * sizeof(std::uint32_t);
+    }
+
+    /**
+     * \fn void DictionnaireCompact::_ajouteEntier(std::vector<unsigned char> &tampon, std::size_t valeur)
+     * \brief Méthode auxiliaire pour ajouter un entier de longueur variable (7 bits par octet, bit fort = suite)
+     * \param[in] tampon Le tampon
+     * \param[in] valeur L'entier
+     */
+    void DictionnaireCompact::_ajouteEntier(std::vector<unsigned char> &tampon, std::size_t valeur)
+    {
+        while (valeur >= 0x80)
+        {
+            tampon.push_back(static_cast<unsigned char>(valeur | 0x80));
+            valeur >>= 7;
+        }
+        tampon.push_back(static_cast<unsigned char>(valeur));
+    }
+
+    /**
+     * \fn std::size_t DictionnaireCompact::_lisEntier(const std::vector<unsigned char> &tampon, std::size_t &position)
+     * \brief Méthode auxiliaire pour lire un entier de longueur variable
+     * \param[in] tampon Le tampon
+     * \param[in,out] position La position de l'entier, avancée après lui
+     * \return L'entier lu
+     */
+    std::size_t DictionnaireCompact::_lisEntier(const std::vector<unsigned char> &tampon, std::size_t &position)
+    {
+        std::size_t valeur = 0;
+        unsigned int decalage = 0;
+        unsigned char octet;
+        do
+        {
+            octet = tampon[position++];
+            valeur |= static_cast<std::size_t>(octet & 0x7F) << decalage;
+            decalage += 7;
+        } while (octet & 0x80);
+        return valeur;
+    }
+
+    /**
+     * \fn bool DictionnaireCompact::_cherche(std::string_view mot, std::size_t &bloc, std::size_t &rang) const
+     * \brief Méthode auxiliaire de recherche : recherche binaire sur les têtes de bloc, puis parcours d'un seul bloc
+     * \param[in] mot Le mot cherché
+     * \param[out] bloc Le bloc du mot
+     * \param[out] rang Le rang du mot dans son bloc
+     * \return true si le mot est trouvé, false sinon
+     * \post Les mots du bloc ne sont pas reconstruits : on compare chaque suffixe en place, en gardant
+     *       la longueur du préfixe commun entre le mot cherché et le mot courant du bloc. Aucune allocation
+     */
+    bool DictionnaireCompact::_cherche(std::string_view mot, std::size_t &bloc, std::size_t &rang) const
+    {
+        // Recherche du dernier bloc dont la tête est < mot. On garde cette tête, déjà décodée
+        std::size_t bas = 0, haut = debutsBlocs.size();
+        std::string_view tete;
+        while (bas < haut)
+        {
+            std::size_t milieu = bas + (haut - bas) / 2;
+            std::size_t position = debutsBlocs[milieu];
+            std::size_t longueur = _lisEntier(mots, position);
+            std::string_view candidate(reinterpret_cast<const char*>(mots.data() + position), longueur);
+            int comparaison = mot.compare(candidate);
+            if (comparaison == 0)
+            {
+                bloc = milieu;
+                rang = 0;
+                return true;
+            }
+            if (comparaison < 0) haut = milieu;
+            else
+            {
+                bas = milieu + 1;
+                tete = candidate;
+            }
+        }
+        if (bas == 0) return false;
+        bloc = bas - 1;
+
+        // egaux : longueur du préfixe commun entre le mot cherché et le mot courant (qui lui est inférieur)
+        std::size_t egaux = 0;
+        while (egaux < tete.size() && egaux < mot.size() && tete[egaux] == mot[egaux]) egaux++;
+
+        std::size_t position = reinterpret_cast<const unsigned char*>(tete.data() + tete.size()) - mots.data();
+        std::size_t fin = (bloc + 1 < debutsBlocs.size()) ? debutsBlocs[bloc + 1] : mots.size();
+        for (rang = 1; position < fin; rang++)
+        {
+            std::size_t commun = _lisEntier(mots, position);
+            std::size_t suffixe = _lisEntier(mots, position);
+            const unsigned char *octets = mots.data() + position;
+            position += suffixe;
+
+            // Le mot courant garde la lettre du précédent qui était déjà inférieure à celle du mot cherché
+            if (commun > egaux) continue;
+            // Le mot courant change une lettre que le précédent partageait avec le mot cherché : il le dépasse
+            if (commun < egaux) return false;
+
+            // commun == egaux : on compare le suffixe au reste du mot cherché
+            std::size_t k = 0;
+            while (k < suffixe && egaux + k < mot.size() && octets[k] == static_cast<unsigned char>(mot[egaux + k])) k++;
+            if (egaux + k == mot.size()) return k == suffixe; // Égal, ou plus long que le mot cherché
+            if (k < suffixe && octets[k] > static_cast<unsigned char>(mot[egaux + k])) return false;
+            egaux += k; // Le mot courant est inférieur : les mots sont triés, on continue
+        }
+        return false;
+    }
+
+}//Fin du namespace
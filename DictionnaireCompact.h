@@ -0,0 +1,73 @@
+/**
+ * \file DictionnaireCompact.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire figé et compressé (codage par préfixe commun).
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef DICO_COMPACT_H_
+#define DICO_COMPACT_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+//classe représentant une copie figée (en lecture seule) d'un Dictionnaire, compressée en mémoire.
+//Les mots, triés, sont regroupés en blocs de TAILLE_BLOC. Le premier mot d'un bloc (sa tête) est
+//stocké en entier, pour la recherche binaire. Les suivants ne stockent que la longueur du préfixe
+//commun avec le mot précédent et le suffixe qui diffère. Les traductions sont regroupées dans un
+//seul tampon d'octets. Une recherche ne décode qu'un seul bloc.
+class DictionnaireCompact
+{
+public:
+
+	// Nombre de mots par bloc
+	static const unsigned int TAILLE_BLOC = 16;
+
+	//Constructeur à partir d'un dictionnaire (qui n'est pas modifié)
+	explicit DictionnaireCompact(const Dictionnaire &dictionnaire);
+
+	//Trouver les traductions possibles d'un mot
+	//Si le mot appartient au dictionnaire, on retourne le vecteur des traductions du mot donné.
+	//Sinon, on retourne un vecteur vide
+	std::vector<std::string> traduit(std::string_view mot) const;
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(std::string_view mot) const;
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Retourner le nombre de mots dans le dictionnaire
+	unsigned int taille() const;
+
+	//Retourner le nombre d'octets occupés par les tampons du dictionnaire
+	std::size_t memoireUtilisee() const;
+
+private:
+
+	std::vector<unsigned char> mots;		// Les blocs de mots codés par préfixe commun
+	std::vector<std::uint32_t> debutsBlocs;		// La position de chaque bloc dans mots
+	std::vector<unsigned char> traductions;		// Pour chaque mot : nombre de traductions, puis chacune (longueur, octets)
+	std::vector<std::uint32_t> debutsTraductions;	// La position des traductions du premier mot de chaque bloc
+	unsigned int cpt;				// Le nombre de mots
+
+	// Méthodes auxiliaires pour coder et décoder les entiers de longueur variable (7 bits par octet)
+	static void _ajouteEntier(std::vector<unsigned char> &tampon, std::size_t valeur);
+	static std::size_t _lisEntier(const std::vector<unsigned char> &tampon, std::size_t &position);
+
+	// Méthode auxiliaire de recherche : retourne true si le mot est trouvé, avec son bloc et son rang dans le bloc
+	bool _cherche(std::string_view mot, std::size_t &bloc, std::size_t &rang) const;
+};
+
+}
+
+#endif /* DICO_COMPACT_H_ */
@@ -0,0 +1,496 @@
+/**
+ * \file DictionnairePersistant.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnairePersistant
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "DictionnairePersistant.h"
+#include <atomic> // pour std::atomic_load et std::atomic_store sur un shared_ptr
+#include <stdexcept>
+
+namespace TP3
+{
+    /**
+     * \fn DictionnairePersistant::NoeudPersistant::NoeudPersistant(std::string mot, std::shared_ptr<const std::vector<std::string> > traductions, Lien gauche, Lien droite)
+     * \brief Constructeur d'un noeud immuable
+     * \param[in] mot Le mot
+     * \param[in] traductions Les traductions du mot (partagées)
+     * \param[in] gauche Le sous-arbre gauche
+     * \param[in] droite Le sous-arbre droit
+     * \post La hauteur et la taille du noeud sont calculées à partir de ses enfants
+     */
+    DictionnairePersistant::NoeudPersistant::NoeudPersistant(std::string mot, std::shared_ptr<const std::vector<std::string> > traductions,
+                                                             Lien gauche, Lien droite)
+        : mot(std::move(mot)), traductions(std::move(traductions)), gauche(std::move(gauche)), droite(std::move(droite))
+    {
+        int max = (_hauteur(this->gauche) > _hauteur(this->droite)) ? _hauteur(this->gauche) : _hauteur(this->droite);
+        hauteur = 1 + max;
+        taille = 1 + (this->gauche ? this->gauche->taille : 0) + (this->droite ? this->droite->taille : 0);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Version::Version()
+     * \brief Constructeur d'une version vide
+     */
+    DictionnairePersistant::Version::Version() {}
+
+    /**
+     * \fn DictionnairePersistant::Version::Version(std::shared_ptr<const NoeudPersistant> racine)
+     * \brief Constructeur d'une version à partir de sa racine
+     * \param[in] racine La racine de l'arbre de la version
+     */
+    DictionnairePersistant::Version::Version(std::shared_ptr<const NoeudPersistant> racine) : racine(std::move(racine)) {}
+
+    /**
+     * \fn std::vector<std::string> DictionnairePersistant::Version::traduit(std::string_view mot) const
+     * \brief Retourne les traductions possibles d'un mot dans cette version
+     * \param[in] mot Le mot à traduire
+     * \return Les traductions du mot, ou un vecteur vide si le mot est absent
+     */
+    std::vector<std::string> DictionnairePersistant::Version::traduit(std::string_view mot) const
+    {
+        const NoeudPersistant *noeud = _accedeMot(racine, mot);
+        if (noeud == nullptr) return std::vector<std::string>();
+        return *noeud->traductions;
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::Version::appartient(std::string_view mot) const
+     * \brief Vérifie si un mot appartient à cette version
+     * \param[in] mot Le mot à vérifier
+     * \return true si le mot appartient à la version, false sinon
+     */
+    bool DictionnairePersistant::Version::appartient(std::string_view mot) const
+    {
+        return _accedeMot(racine, mot) != nullptr;
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::Version::estVide() const
+     * \brief Vérifie si cette version est vide
+     * \return true si la version est vide, false sinon
+     */
+    bool DictionnairePersistant::Version::estVide() const
+    {
+        return racine == nullptr;
+    }
+
+    /**
+     * \fn unsigned int DictionnairePersistant::Version::taille() const
+     * \brief Retourne le nombre de mots de cette version
+     * \return Le nombre de mots (gardé dans la racine : O(1))
+     */
+    unsigned int DictionnairePersistant::Version::taille() const
+    {
+        return (racine == nullptr) ? 0 : racine->taille;
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::Version::estEquilibre() const
+     * \brief Vérifie si l'arbre AVL de cette version est équilibré
+     * \return true si l'arbre est équilibré, false sinon
+     */
+    bool DictionnairePersistant::Version::estEquilibre() const
+    {
+        return _estEquilibre(racine);
+    }
+
+    /**
+     * \fn DictionnairePersistant::DictionnairePersistant()
+     * \brief Constructeur d'un dictionnaire persistant vide
+     */
+    DictionnairePersistant::DictionnairePersistant() {}
+
+    /**
+     * \fn DictionnairePersistant::DictionnairePersistant(const Dictionnaire &dictionnaire)
+     * \brief Constructeur d'un dictionnaire persistant à partir d'un dictionnaire
+     * \param[in] dictionnaire Le dictionnaire à copier. Il n'est pas modifié
+     * \post La version actuelle contient les mêmes mots et traductions, dans un arbre parfaitement équilibré
+     */
+    DictionnairePersistant::DictionnairePersistant(const Dictionnaire &dictionnaire)
+    {
+        std::vector<Dictionnaire::NoeudDictionnaire*> noeuds;
+        noeuds.reserve(dictionnaire.taille());
+        dictionnaire._aplatit(dictionnaire.racine, noeuds);
+        racine = _construitEquilibre(noeuds, 0, noeuds.size());
+    }
+
+    /**
+     * \fn void DictionnairePersistant::ajouteMot(const std::string &motOriginal, const std::string &motTraduit)
+     * \brief Ajoute un mot au dictionnaire et l'une de ses traductions dans une nouvelle version
+     * \param[in] motOriginal Le mot original
+     * \param[in] motTraduit Le mot traduit
+     * \post Seuls les noeuds du chemin vers le mot sont copiés. Les versions gardées ne changent pas
+     * \post Si la traduction était déjà présente, la version actuelle reste la même
+     */
+    void DictionnairePersistant::ajouteMot(const std::string &motOriginal, const std::string &motTraduit)
+    {
+        std::lock_guard<std::mutex> verrou(ecriture);
+        _publie(_ajouteMot(_racine(), motOriginal, motTraduit));
+    }
+
+    /**
+     * \fn void DictionnairePersistant::supprimeMot(std::string_view motOriginal)
+     * \brief Supprime un mot dans une nouvelle version
+     * \param[in] motOriginal Le mot à supprimer
+     * \pre Le dictionnaire n'est pas vide
+     * \pre Le mot existe dans le dictionnaire
+     * \post Seuls les noeuds du chemin vers le mot (et vers son successeur) sont copiés
+     * \exception logic_error Le dictionnaire est vide
+     * \exception logic_error Le mot n'existe pas dans le dictionnaire (la version actuelle ne change pas)
+     */
+    void DictionnairePersistant::supprimeMot(std::string_view motOriginal)
+    {
+        std::lock_guard<std::mutex> verrou(ecriture);
+        Lien actuelle = _racine();
+        if (actuelle == nullptr) throw std::logic_error("Le dictionnaire est vide");
+        _publie(_supprimeMot(actuelle, motOriginal));
+    }
+
+    /**
+     * \fn DictionnairePersistant::Version DictionnairePersistant::versionCourante() const
+     * \brief Retourne la version actuelle du dictionnaire
+     * \return La version actuelle (une copie de la racine : O(1))
+     */
+    DictionnairePersistant::Version DictionnairePersistant::versionCourante() const
+    {
+        return Version(_racine());
+    }
+
+    /**
+     * \fn void DictionnairePersistant::restaure(const Version &version)
+     * \brief Fait d'une version la version actuelle du dictionnaire
+     * \param[in] version La version à restaurer
+     * \post Les lectures suivantes voient la version restaurée. Les autres versions gardées ne changent pas
+     */
+    void DictionnairePersistant::restaure(const Version &version)
+    {
+        std::lock_guard<std::mutex> verrou(ecriture);
+        _publie(version.racine);
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnairePersistant::traduit(std::string_view mot) const
+     * \brief Retourne les traductions possibles d'un mot dans la version actuelle
+     * \param[in] mot Le mot à traduire
+     * \return Les traductions du mot, ou un vecteur vide si le mot est absent
+     */
+    std::vector<std::string> DictionnairePersistant::traduit(std::string_view mot) const
+    {
+        return versionCourante().traduit(mot);
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::appartient(std::string_view mot) const
+     * \brief Vérifie si un mot appartient à la version actuelle
+     * \param[in] mot Le mot à vérifier
+     * \return true si le mot appartient au dictionnaire, false sinon
+     */
+    bool DictionnairePersistant::appartient(std::string_view mot) const
+    {
+        return versionCourante().appartient(mot);
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::estVide() const
+     * \brief Vérifie si le dictionnaire est vide
+     * \return true si le dictionnaire est vide, false sinon
+     */
+    bool DictionnairePersistant::estVide() const
+    {
+        return versionCourante().estVide();
+    }
+
+    /**
+     * \fn unsigned int DictionnairePersistant::taille() const
+     * \brief Retourne le nombre de mots dans le dictionnaire
+     * \return Le nombre de mots de la version actuelle
+     */
+    unsigned int DictionnairePersistant::taille() const
+    {
+        return versionCourante().taille();
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::estEquilibre() const
+     * \brief Vérifie si l'arbre AVL actuel est équilibré
+     * \return true si l'arbre est équilibré, false sinon
+     */
+    bool DictionnairePersistant::estEquilibre() const
+    {
+        return versionCourante().estEquilibre();
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_racine() const
+     * \brief Méthode privée pour lire la racine actuelle de façon atomique
+     * \return La racine actuelle
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_racine() const
+    {
+        return std::atomic_load(&racine);
+    }
+
+    /**
+     * \fn void DictionnairePersistant::_publie(Lien nouvelleRacine)
+     * \brief Méthode privée pour remplacer la racine actuelle de façon atomique
+     * \param[in] nouvelleRacine La racine de la nouvelle version
+     * \pre Le verrou d'écriture est pris
+     * \post Les noeuds qui ne sont plus dans aucune version sont libérés
+     */
+    void DictionnairePersistant::_publie(Lien nouvelleRacine)
+    {
+        std::atomic_store(&racine, std::move(nouvelleRacine));
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_construitEquilibre(const std::vector<Dictionnaire::NoeudDictionnaire*> &noeuds, std::size_t debut, std::size_t fin)
+     * \brief Méthode auxiliaire au constructeur pour créer un arbre parfaitement équilibré à partir de noeuds triés
+     * \param[in] noeuds Les noeuds du dictionnaire, en ordre croissant des mots
+     * \param[in] debut L'indice du premier noeud du sous-arbre
+     * \param[in] fin L'indice suivant le dernier noeud du sous-arbre
+     * \return La racine du sous-arbre créé (nullptr s'il est vide)
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_construitEquilibre(const std::vector<Dictionnaire::NoeudDictionnaire*> &noeuds,
+                                                                             std::size_t debut, std::size_t fin)
+    {
+        if (debut >= fin) return nullptr;
+        std::size_t milieu = debut + (fin - debut) / 2;
+        Lien gauche = _construitEquilibre(noeuds, debut, milieu);
+        Lien droite = _construitEquilibre(noeuds, milieu + 1, fin);
+        return std::make_shared<const NoeudPersistant>(noeuds[milieu]->mot,
+                                                       std::make_shared<const std::vector<std::string> >(noeuds[milieu]->traductions),
+                                                       std::move(gauche), std::move(droite));
+    }
+
+    /**
+     * \fn const DictionnairePersistant::NoeudPersistant* DictionnairePersistant::_accedeMot(const Lien &arbre, std::string_view mot)
+     * \brief Méthode privée pour accéder à un mot dans un arbre
+     * \param[in] arbre La racine de l'arbre
+     * \param[in] mot Le mot cherché
+     * \return Le noeud du mot, ou nullptr s'il est absent
+     * \post Aucun compteur de référence n'est touché : l'appelant garde l'arbre en vie
+     */
+    const DictionnairePersistant::NoeudPersistant* DictionnairePersistant::_accedeMot(const Lien &arbre, std::string_view mot)
+    {
+        const NoeudPersistant *noeud = arbre.get();
+        while (noeud != nullptr)
+        {
+            int comparaison = mot.compare(noeud->mot);
+            if (comparaison == 0) return noeud;
+            noeud = (comparaison < 0) ? noeud->gauche.get() : noeud->droite.get();
+        }
+        return nullptr;
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_ajouteMot(const Lien &arbre, const std::string &motOriginal, const std::string &motTraduit)
+     * \brief Méthode auxiliaire à ajouteMot pour ajouter un mot par récursivité, en copiant le chemin
+     * \param[in] arbre Le sous-arbre (non modifié)
+     * \param[in] motOriginal Le mot original à ajouter
+     * \param[in] motTraduit Le mot traduit à ajouter
+     * \return La racine du nouveau sous-arbre, équilibré. C'est arbre lui-même si rien n'a changé
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_ajouteMot(const Lien &arbre, const std::string &motOriginal, const std::string &motTraduit)
+    {
+        if (arbre == nullptr)
+        {
+            return std::make_shared<const NoeudPersistant>(motOriginal, std::make_shared<const std::vector<std::string> >(1, motTraduit),
+                                                           nullptr, nullptr);
+        }
+
+        if (motOriginal < arbre->mot)
+        {
+            Lien gauche = _ajouteMot(arbre->gauche, motOriginal, motTraduit);
+            if (gauche == arbre->gauche) return arbre;
+            return _equilibreAVL(*arbre, gauche, arbre->droite);
+        }
+        if (motOriginal > arbre->mot)
+        {
+            Lien droite = _ajouteMot(arbre->droite, motOriginal, motTraduit);
+            if (droite == arbre->droite) return arbre;
+            return _equilibreAVL(*arbre, arbre->gauche, droite);
+        }
+
+        // Le mot existe déjà : seul son noeud est copié, avec une nouvelle liste de traductions
+        const std::vector<std::string> &traductions = *arbre->traductions;
+        for (std::size_t i = 0; i < traductions.size(); i++)
+        {
+            if (traductions[i] == motTraduit) return arbre;
+        }
+        std::shared_ptr<std::vector<std::string> > nouvelles = std::make_shared<std::vector<std::string> >();
+        nouvelles->reserve(traductions.size() + 1);
+        *nouvelles = traductions;
+        nouvelles->push_back(motTraduit);
+        return std::make_shared<const NoeudPersistant>(arbre->mot, std::move(nouvelles), arbre->gauche, arbre->droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_supprimeMot(const Lien &arbre, std::string_view motOriginal)
+     * \brief Méthode auxiliaire à supprimeMot pour supprimer un mot par récursivité, en copiant le chemin
+     * \param[in] arbre Le sous-arbre (non modifié)
+     * \param[in] motOriginal Le mot à supprimer
+     * \return La racine du nouveau sous-arbre, équilibré
+     * \exception logic_error Le mot n'existe pas dans le dictionnaire
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_supprimeMot(const Lien &arbre, std::string_view motOriginal)
+    {
+        if (arbre == nullptr)
+        {
+            throw std::logic_error("Le mot n'existe pas dans le dictionnaire");
+        }
+
+        if (motOriginal < arbre->mot) return _equilibreAVL(*arbre, _supprimeMot(arbre->gauche, motOriginal), arbre->droite);
+        if (motOriginal > arbre->mot) return _equilibreAVL(*arbre, arbre->gauche, _supprimeMot(arbre->droite, motOriginal));
+
+        // Cas simple: le noeud a un seul enfant ou aucun enfant. Le sous-arbre restant est partagé tel quel
+        if (arbre->gauche == nullptr) return arbre->droite;
+        if (arbre->droite == nullptr) return arbre->gauche;
+
+        // Cas complexe: le noeud a deux enfants. On le remplace par le plus petit mot de l'arbre droit
+        Lien min;
+        Lien droite = _detacheMin(arbre->droite, min);
+        return _equilibreAVL(*min, arbre->gauche, droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_detacheMin(const Lien &arbre, Lien &min)
+     * \brief Méthode auxiliaire à _supprimeMot pour retirer le plus petit mot d'un sous-arbre
+     * \param[in] arbre Le sous-arbre (non modifié)
+     * \param[out] min Le noeud du plus petit mot (son mot et ses traductions seront réutilisés)
+     * \pre Le sous-arbre n'est pas vide
+     * \return La racine du nouveau sous-arbre, sans le plus petit mot, équilibré
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_detacheMin(const Lien &arbre, Lien &min)
+    {
+        if (arbre->gauche == nullptr)
+        {
+            min = arbre;
+            return arbre->droite;
+        }
+        Lien gauche = _detacheMin(arbre->gauche, min);
+        return _equilibreAVL(*arbre, gauche, arbre->droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_noeud(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite)
+     * \brief Méthode privée pour créer une copie d'un noeud avec d'autres enfants
+     * \param[in] modele Le noeud dont le mot et les traductions (partagées, non copiées) sont repris
+     * \param[in] gauche Le nouveau sous-arbre gauche
+     * \param[in] droite Le nouveau sous-arbre droit
+     * \return Le nouveau noeud
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_noeud(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite)
+    {
+        return std::make_shared<const NoeudPersistant>(modele.mot, modele.traductions, gauche, droite);
+    }
+
+    /**
+     * \fn int DictionnairePersistant::_hauteur(const Lien &arbre)
+     * \brief Méthode privée pour calculer la hauteur d'un sous-arbre
+     * \param[in] arbre Le sous-arbre
+     * \return La hauteur du sous-arbre (ou -1 si le sous-arbre est vide)
+     */
+    int DictionnairePersistant::_hauteur(const Lien &arbre)
+    {
+        return (arbre == nullptr) ? -1 : arbre->hauteur;
+    }
+
+    /**
+     * \fn bool DictionnairePersistant::_estEquilibre(const Lien &arbre)
+     * \brief Méthode récursive auxiliaire à estEquilibre pour savoir si un sous-arbre est équilibré
+     * \param[in] arbre Le sous-arbre
+     * \return true si le sous-arbre est équilibré, false sinon
+     */
+    bool DictionnairePersistant::_estEquilibre(const Lien &arbre)
+    {
+        if (arbre == nullptr) return true;
+        int difference = _hauteur(arbre->gauche) - _hauteur(arbre->droite);
+        return difference >= -1 && difference <= 1 && _estEquilibre(arbre->gauche) && _estEquilibre(arbre->droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_equilibreAVL(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite)
+     * \brief Méthode privée pour créer un sous-arbre équilibré à partir d'un noeud et de ses nouveaux enfants.
+     *        Utilisé lors de la remontée par les méthodes récursives, comme Dictionnaire::_equilibreAVL
+     * \param[in] modele Le noeud dont le mot et les traductions sont repris
+     * \param[in] gauche Le nouveau sous-arbre gauche (équilibré)
+     * \param[in] droite Le nouveau sous-arbre droit (équilibré)
+     * \return La racine du sous-arbre équilibré
+     * \post Aucun noeud existant n'est modifié : les rotations créent au plus 3 nouveaux noeuds
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_equilibreAVL(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite)
+    {
+        if (_hauteur(gauche) - _hauteur(droite) > 1)
+        {
+            // On fait un zigZig lorsque le sous-arbre gauche penche à gauche OU est balancé.
+            if (_hauteur(gauche->gauche) >= _hauteur(gauche->droite)) return _zigZigGauche(modele, gauche, droite);
+            return _zigZagGauche(modele, gauche, droite);
+        }
+        if (_hauteur(droite) - _hauteur(gauche) > 1)
+        {
+            // On fait un zigZig lorsque le sous-arbre droit penche à droite OU est balancé.
+            if (_hauteur(droite->droite) >= _hauteur(droite->gauche)) return _zigZigDroit(modele, gauche, droite);
+            return _zigZagDroit(modele, gauche, droite);
+        }
+        return _noeud(modele, gauche, droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_zigZigGauche(const NoeudPersistant &K2, const Lien &K1, const Lien &droite)
+     * \brief Méthode auxiliaire à _equilibreAVL pour une rotation à droite par copie
+     * \param[in] K2 Le noeud débalancé
+     * \param[in] K1 Son nouveau sous-arbre gauche
+     * \param[in] droite Son nouveau sous-arbre droit
+     * \return La nouvelle racine (une copie de K1), dont l'enfant droit est une copie de K2
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_zigZigGauche(const NoeudPersistant &K2, const Lien &K1, const Lien &droite)
+    {
+        return _noeud(*K1, K1->gauche, _noeud(K2, K1->droite, droite));
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_zigZigDroit(const NoeudPersistant &K2, const Lien &gauche, const Lien &K1)
+     * \brief Méthode auxiliaire à _equilibreAVL pour une rotation à gauche par copie
+     * \param[in] K2 Le noeud débalancé
+     * \param[in] gauche Son nouveau sous-arbre gauche
+     * \param[in] K1 Son nouveau sous-arbre droit
+     * \return La nouvelle racine (une copie de K1), dont l'enfant gauche est une copie de K2
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_zigZigDroit(const NoeudPersistant &K2, const Lien &gauche, const Lien &K1)
+    {
+        return _noeud(*K1, _noeud(K2, gauche, K1->gauche), K1->droite);
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_zigZagGauche(const NoeudPersistant &K3, const Lien &K1, const Lien &droite)
+     * \brief Méthode auxiliaire à _equilibreAVL pour une double rotation (zigZag à gauche) par copie
+     * \param[in] K3 Le noeud débalancé
+     * \param[in] K1 Son nouveau sous-arbre gauche, qui penche à droite
+     * \param[in] droite Son nouveau sous-arbre droit
+     * \return La nouvelle racine (une copie de K1->droite), avec des copies de K1 et K3 pour enfants
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_zigZagGauche(const NoeudPersistant &K3, const Lien &K1, const Lien &droite)
+    {
+        const Lien &K2 = K1->droite;
+        return _noeud(*K2, _noeud(*K1, K1->gauche, K2->gauche), _noeud(K3, K2->droite, droite));
+    }
+
+    /**
+     * \fn DictionnairePersistant::Lien DictionnairePersistant::_zigZagDroit(const NoeudPersistant &K3, const Lien &gauche, const Lien &K1)
+     * \brief Méthode auxiliaire à _equilibreAVL pour une double rotation (zigZag à droite) par copie
+     * \param[in] K3 Le noeud débalancé
+     * \param[in] gauche Son nouveau sous-arbre gauche
+     * \param[in] K1 Son nouveau sous-arbre droit, qui penche à gauche
+     * \return La nouvelle racine (une copie de K1->gauche), avec des copies de K3 et K1 pour enfants
+     */
+    DictionnairePersistant::Lien DictionnairePersistant::_zigZagDroit(const NoeudPersistant &K3, const Lien &gauche, const Lien &K1)
+    {
+        const Lien &K2 = K1->gauche;
+        return _noeud(*K2, _noeud(K3, gauche, K2->gauche), _noeud(*K1, K2->droite, K1->droite));
+    }
+
+}//Fin du namespace
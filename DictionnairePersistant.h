@@ -0,0 +1,157 @@
+/**
+ * \file DictionnairePersistant.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire persistant (arbre AVL immuable, à versions).
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef DICO_PERSISTANT_H_
+#define DICO_PERSISTANT_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+//classe représentant un dictionnaire dont l'arbre AVL n'est jamais modifié en place.
+//Une modification copie seulement les O(log n) noeuds du chemin vers le mot (rotations comprises) et
+//partage tout le reste avec la version précédente. Chaque version est donc une simple racine :
+//la garder coûte O(1), la lire ne demande aucun verrou et la restaurer est instantané.
+//Les lectures sont sûres pendant les écritures, qui sont sérialisées entre elles.
+class DictionnairePersistant
+{
+private:
+
+	struct NoeudPersistant;
+
+public:
+
+	//classe représentant une version figée du dictionnaire (copie en O(1), lecture seule)
+	//Elle reste valide et inchangée même après des modifications ou une restauration du dictionnaire.
+	class Version
+	{
+	public:
+
+		//Constructeur d'une version vide
+		Version();
+
+		//Trouver les traductions possibles d'un mot dans cette version (vecteur vide si le mot est absent)
+		std::vector<std::string> traduit(std::string_view mot) const;
+
+		//Vérifier si le mot donné appartient à cette version
+		bool appartient(std::string_view mot) const;
+
+		//Vérifier si cette version est vide
+		bool estVide() const;
+
+		//Retourner le nombre de mots de cette version
+		unsigned int taille() const;
+
+		//Vérifier si l'arbre AVL de cette version est équilibré
+		bool estEquilibre() const;
+
+	private:
+
+		friend class DictionnairePersistant;
+
+		std::shared_ptr<const NoeudPersistant> racine;	// La racine de l'arbre de cette version
+
+		explicit Version(std::shared_ptr<const NoeudPersistant> racine);
+	};
+
+	//Constructeur d'un dictionnaire vide
+	DictionnairePersistant();
+
+	//Constructeur à partir d'un dictionnaire (qui n'est pas modifié)
+	explicit DictionnairePersistant(const Dictionnaire &dictionnaire);
+
+	//Ajouter un mot au dictionnaire et l'une de ses traductions, dans une nouvelle version
+	void ajouteMot(const std::string &motOriginal, const std::string &motTraduit);
+
+	//Supprimer un mot, dans une nouvelle version
+	//Exception	logic_error si le dictionnaire est vide
+	//Exception	logic_error si le mot n'appartient pas au dictionnaire
+	void supprimeMot(std::string_view motOriginal);
+
+	//Retourner la version actuelle du dictionnaire (O(1))
+	Version versionCourante() const;
+
+	//Faire d'une version (actuelle ou ancienne) la version actuelle du dictionnaire (O(1))
+	void restaure(const Version &version);
+
+	//Trouver les traductions possibles d'un mot dans la version actuelle
+	std::vector<std::string> traduit(std::string_view mot) const;
+
+	//Vérifier si le mot donné appartient à la version actuelle
+	bool appartient(std::string_view mot) const;
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Retourner le nombre de mots dans le dictionnaire
+	unsigned int taille() const;
+
+	//Vérifier si l'arbre AVL actuel est équilibré
+	bool estEquilibre() const;
+
+private:
+
+	typedef std::shared_ptr<const NoeudPersistant> Lien;
+
+	// Un noeud immuable. Les traductions sont partagées entre les copies d'un même mot
+	struct NoeudPersistant
+	{
+		std::string mot;						// Un mot (en anglais)
+		std::shared_ptr<const std::vector<std::string> > traductions;	// Ses traductions en français
+		Lien gauche, droite;						// Les enfants du noeud (partagés entre versions)
+		int hauteur;							// La hauteur du noeud
+		unsigned int taille;						// Le nombre de mots du sous-arbre
+
+		NoeudPersistant(std::string mot, std::shared_ptr<const std::vector<std::string> > traductions, Lien gauche, Lien droite);
+	};
+
+	Lien racine;		// La racine de la version actuelle (lue et remplacée atomiquement)
+	std::mutex ecriture;	// Sérialise les modifications
+
+	// Méthode privée pour lire et remplacer la racine actuelle de façon atomique
+	Lien _racine() const;
+	void _publie(Lien nouvelleRacine);
+
+	// Méthode auxiliaire au constructeur pour relier des noeuds triés en un arbre équilibré
+	static Lien _construitEquilibre(const std::vector<Dictionnaire::NoeudDictionnaire*> &noeuds, std::size_t debut, std::size_t fin);
+
+	// Méthode privée pour accéder à un mot dans une version
+	static const NoeudPersistant* _accedeMot(const Lien &arbre, std::string_view mot);
+
+	// Méthodes auxiliaires à ajouteMot et supprimeMot : elles retournent la racine du sous-arbre copié
+	static Lien _ajouteMot(const Lien &arbre, const std::string &motOriginal, const std::string &motTraduit);
+	static Lien _supprimeMot(const Lien &arbre, std::string_view motOriginal);
+	static Lien _detacheMin(const Lien &arbre, Lien &min);
+
+	// Méthode privée pour créer un noeud avec le contenu d'un autre (mot et traductions) et les enfants donnés
+	static Lien _noeud(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite);
+
+	// Méthodes privées pour la hauteur et l'équilibre d'un sous-arbre
+	static int _hauteur(const Lien &arbre);
+	static bool _estEquilibre(const Lien &arbre);
+
+	// Méthode privée pour créer un sous-arbre équilibré à partir d'un noeud modèle et de ses nouveaux enfants
+	// Méthodes auxiliaires à _equilibreAVL : les rotations créent de nouveaux noeuds au lieu de modifier les anciens
+	static Lien _equilibreAVL(const NoeudPersistant &modele, const Lien &gauche, const Lien &droite);
+	static Lien _zigZigGauche(const NoeudPersistant &K2, const Lien &K1, const Lien &droite);
+	static Lien _zigZigDroit(const NoeudPersistant &K2, const Lien &gauche, const Lien &K1);
+	static Lien _zigZagGauche(const NoeudPersistant &K3, const Lien &K1, const Lien &droite);
+	static Lien _zigZagDroit(const NoeudPersistant &K3, const Lien &gauche, const Lien &K1);
+};
+
+}
+
+#endif /* DICO_PERSISTANT_H_ */
@@ -0,0 +1,494 @@
+/**
+ * \file DictionnaireReparti.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe DictionnaireReparti
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "DictionnaireReparti.h"
+#include <algorithm>
+#include <functional> // pour std::hash
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h> // pour fixer un écrivain à un coeur
+#endif
+
+// Limite du nombre de suggestions (la même que dans Dictionnaire.cpp)
+#define LIMITE_SUGGESTIONS 5
+
+namespace TP3
+{
+    /**
+     * \fn DictionnaireReparti::DictionnaireReparti(unsigned int nbFragments)
+     * \brief Constructeur d'un dictionnaire réparti vide
+     * \param[in] nbFragments Le nombre de fragments (0 est traité comme 1)
+     * \post Un dictionnaire réparti vide de nbFragments fragments est créé
+     */
+    DictionnaireReparti::DictionnaireReparti(unsigned int nbFragments)
+    {
+        _creeFragments(nbFragments);
+    }
+
+    /**
+     * \fn DictionnaireReparti::DictionnaireReparti(std::ifstream &fichier, unsigned int nbFragments)
+     * \brief Constructeur d'un dictionnaire réparti à partir d'un fichier au format IDP
+     * \param[in] fichier Le fichier du dictionnaire
+     * \param[in] nbFragments Le nombre de fragments (0 est traité comme 1)
+     * \pre Le fichier doit être ouvert au préalable
+     * \post Le dictionnaire contient les mêmes mots et traductions que Dictionnaire(fichier)
+     */
+    DictionnaireReparti::DictionnaireReparti(std::ifstream &fichier, unsigned int nbFragments)
+    {
+        _creeFragments(nbFragments);
+
+        std::vector<std::pair<std::string, std::string> > mots;
+        std::string motAnglais, motTraduit;
+        for (std::string ligneDico; getline(fichier, ligneDico); )
+        {
+            if (Dictionnaire::lisLigne(ligneDico, motAnglais, motTraduit))
+            {
+                // lisLigne réaffecte les deux chaînes à chaque ligne : on peut les déplacer
+                mots.push_back(std::make_pair(std::move(motAnglais), std::move(motTraduit)));
+            }
+        }
+        ajouteMots(std::move(mots));
+    }
+
+    /**
+     * \fn DictionnaireReparti::~DictionnaireReparti()
+     * \brief Destructeur : arrête les écrivains (s'il y en a) après qu'ils ont appliqué leurs files
+     */
+    DictionnaireReparti::~DictionnaireReparti()
+    {
+        arreteEcrivains();
+    }
+
+    /**
+     * \fn void DictionnaireReparti::ajouteMot(const std::string &motOriginal, const std::string &motTraduit)
+     * \brief Ajoute un mot et l'une de ses traductions dans le fragment du mot
+     * \param[in] motOriginal Le mot original
+     * \param[in] motTraduit Le mot traduit
+     * \post Seul le fragment du mot est verrouillé pendant l'ajout
+     */
+    void DictionnaireReparti::ajouteMot(const std::string &motOriginal, const std::string &motTraduit)
+    {
+        Fragment &fragment = *fragments[fragmentDe(motOriginal)];
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dictionnaire.ajouteMot(motOriginal, motTraduit);
+    }
+
+    /**
+     * \fn void DictionnaireReparti::ajouteMot(std::string &&motOriginal, std::string &&motTraduit)
+     * \brief Ajoute un mot et l'une de ses traductions dans le fragment du mot, en déplaçant les chaînes
+     * \param[in] motOriginal Le mot original, déplacé dans le nouveau noeud s'il est absent
+     * \param[in] motTraduit Le mot traduit, déplacé dans le noeud s'il n'y est pas déjà
+     * \post Comme l'autre ajouteMot, sans copier les chaînes
+     */
+    void DictionnaireReparti::ajouteMot(std::string &&motOriginal, std::string &&motTraduit)
+    {
+        Fragment &fragment = *fragments[fragmentDe(motOriginal)];
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dictionnaire.ajouteMot(std::move(motOriginal), std::move(motTraduit));
+    }
+
+    /**
+     * \fn void DictionnaireReparti::ajouteMots(const std::vector<std::pair<std::string, std::string> > &mots)
+     * \brief Ajoute un lot de paires (mot, traduction), chaque fragment étant rempli par son propre thread
+     * \param[in] mots Les paires à ajouter
+     * \post Pour un même mot, les traductions sont ajoutées dans l'ordre du lot
+     */
+    void DictionnaireReparti::ajouteMots(const std::vector<std::pair<std::string, std::string> > &mots)
+    {
+        ajouteMots(std::vector<std::pair<std::string, std::string> >(mots));
+    }
+
+    /**
+     * \fn void DictionnaireReparti::ajouteMots(std::vector<std::pair<std::string, std::string> > &&mots)
+     * \brief Ajoute un lot de paires (mot, traduction) en déplaçant leurs chaînes dans les fragments
+     * \param[in] mots Les paires à ajouter. Leurs chaînes sont déplacées
+     * \post Pour un même mot, les traductions sont ajoutées dans l'ordre du lot
+     */
+    void DictionnaireReparti::ajouteMots(std::vector<std::pair<std::string, std::string> > &&mots)
+    {
+        // On regroupe les indices des paires par fragment (l'ordre du lot est conservé dans chaque groupe)
+        std::vector<std::vector<std::size_t> > groupes(fragments.size());
+        for (std::size_t i = 0; i < mots.size(); i++)
+        {
+            groupes[fragmentDe(mots[i].first)].push_back(i);
+        }
+
+        auto remplis = [&](std::size_t f)
+        {
+            std::unique_lock<std::shared_mutex> verrou(fragments[f]->verrou);
+            for (std::size_t i : groupes[f])
+            {
+                fragments[f]->dictionnaire.ajouteMot(std::move(mots[i].first), std::move(mots[i].second));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (std::size_t f = 1; f < fragments.size(); f++)
+        {
+            if (!groupes[f].empty()) threads.push_back(std::thread(remplis, f));
+        }
+        remplis(0); // Le thread appelant s'occupe du premier fragment
+        for (std::size_t t = 0; t < threads.size(); t++) threads[t].join();
+    }
+
+    /**
+     * \fn void DictionnaireReparti::appliqueDelta(std::ifstream &fichier)
+     * \brief Applique un fichier delta en un seul lot, de façon atomique pour les lecteurs (d'un mot ou
+     *        de tous les fragments, voir _verrouilleLecture)
+     * \param[in] fichier Le fichier delta, ouvert au préalable
+     * \post Les opérations sont validées et regroupées par fragment avant la prise des verrous
+     * \post Les verrous exclusifs de tous les fragments sont pris dans l'ordre des indices (pas d'interblocage
+     *       entre deux lots) et gardés jusqu'à la fin du lot
+     * \exception logic_error Si une ligne est mal formée. Le dictionnaire n'est alors pas modifié
+     */
+    void DictionnaireReparti::appliqueDelta(std::ifstream &fichier)
+    {
+        std::vector<Dictionnaire::OperationDelta> operations = Dictionnaire::_lisDelta(fichier);
+
+        std::vector<std::vector<Dictionnaire::OperationDelta> > groupes(fragments.size());
+        for (std::size_t i = 0; i < operations.size(); i++)
+        {
+            groupes[fragmentDe(operations[i].mot)].push_back(std::move(operations[i]));
+        }
+
+        std::vector<std::unique_lock<std::shared_mutex> > verrous;
+        verrous.reserve(fragments.size());
+        for (std::size_t f = 0; f < fragments.size(); f++) verrous.emplace_back(fragments[f]->verrou);
+        for (std::size_t f = 0; f < fragments.size(); f++)
+        {
+            fragments[f]->dictionnaire._appliqueOperations(groupes[f]);
+        }
+    }
+
+    /**
+     * \fn void DictionnaireReparti::supprimeMot(std::string_view motOriginal)
+     * \brief Supprime un mot et ses traductions de son fragment
+     * \param[in] motOriginal Le mot à supprimer
+     * \exception logic_error Si le mot n'existe pas dans le dictionnaire
+     */
+    void DictionnaireReparti::supprimeMot(std::string_view motOriginal)
+    {
+        Fragment &fragment = *fragments[fragmentDe(motOriginal)];
+        std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+        fragment.dictionnaire.supprimeMot(motOriginal);
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireReparti::suggereCorrections(std::string_view motMalEcrit)
+     * \brief Suggère jusqu'à 5 corrections pour un mot mal écrit, en parcourant les fragments en parallèle
+     * \param[in] motMalEcrit Le mot mal écrit
+     * \return Les mêmes suggestions que Dictionnaire::suggereCorrections sur le dictionnaire complet
+     * \post Chaque fragment donne ses 5 premières suggestions en ordre alphabétique : les 5 premières
+     *       de leur fusion sont donc les 5 premières du dictionnaire complet
+     * \post Tous les fragments restent verrouillés en lecture (par le thread appelant) jusqu'à la fusion :
+     *       les suggestions viennent toutes du même état du dictionnaire
+     */
+    std::vector<std::string> DictionnaireReparti::suggereCorrections(std::string_view motMalEcrit)
+    {
+        std::vector<std::string> suggestions;
+        std::vector<std::shared_lock<std::shared_mutex> > verrous = _verrouilleLecture();
+        if (fragments[fragmentDe(motMalEcrit)]->dictionnaire.appartient(motMalEcrit)) return suggestions;
+
+        auto suggere = [&](std::size_t f)
+        {
+            return fragments[f]->dictionnaire.suggereCorrections(motMalEcrit);
+        };
+
+        std::vector<std::future<std::vector<std::string> > > resultats;
+        for (std::size_t f = 1; f < fragments.size(); f++)
+        {
+            resultats.push_back(std::async(std::launch::async, suggere, f));
+        }
+        suggestions = suggere(0);
+        for (std::size_t f = 0; f < resultats.size(); f++)
+        {
+            std::vector<std::string> partielles = resultats[f].get();
+            suggestions.insert(suggestions.end(), partielles.begin(), partielles.end());
+        }
+
+        std::sort(suggestions.begin(), suggestions.end());
+        if (suggestions.size() > LIMITE_SUGGESTIONS)
+        {
+            suggestions.erase(suggestions.begin() + LIMITE_SUGGESTIONS, suggestions.end());
+        }
+        return suggestions;
+    }
+
+    /**
+     * \fn std::vector<std::string> DictionnaireReparti::traduit(std::string_view mot)
+     * \brief Retourne les traductions possibles d'un mot
+     * \param[in] mot Le mot à traduire
+     * \return Les traductions du mot, ou un vecteur vide si le mot est absent
+     */
+    std::vector<std::string> DictionnaireReparti::traduit(std::string_view mot)
+    {
+        Fragment &fragment = *fragments[fragmentDe(mot)];
+        std::shared_lock<std::shared_mutex> verrou(fragment.verrou);
+        return fragment.dictionnaire.traduit(mot);
+    }
+
+    /**
+     * \fn bool DictionnaireReparti::appartient(std::string_view mot)
+     * \brief Vérifie si un mot appartient au dictionnaire
+     * \param[in] mot Le mot à vérifier
+     * \return true si le mot appartient au dictionnaire, false sinon
+     */
+    bool DictionnaireReparti::appartient(std::string_view mot)
+    {
+        Fragment &fragment = *fragments[fragmentDe(mot)];
+        std::shared_lock<std::shared_mutex> verrou(fragment.verrou);
+        return fragment.dictionnaire.appartient(mot);
+    }
+
+    /**
+     * \fn bool DictionnaireReparti::estVide() const
+     * \brief Vérifie si le dictionnaire est vide
+     * \return true si tous les fragments sont vides, false sinon
+     */
+    bool DictionnaireReparti::estVide() const
+    {
+        return taille() == 0;
+    }
+
+    /**
+     * \fn unsigned int DictionnaireReparti::taille() const
+     * \brief Retourne le nombre de mots dans le dictionnaire
+     * \return La somme des tailles des fragments, tous verrouillés en même temps
+     */
+    unsigned int DictionnaireReparti::taille() const
+    {
+        std::vector<std::shared_lock<std::shared_mutex> > verrous = _verrouilleLecture();
+        unsigned int total = 0;
+        for (std::size_t f = 0; f < fragments.size(); f++) total += fragments[f]->dictionnaire.taille();
+        return total;
+    }
+
+    /**
+     * \fn bool DictionnaireReparti::estEquilibre() const
+     * \brief Vérifie si les arbres AVL de tous les fragments sont équilibrés
+     * \return true si tous les fragments (verrouillés en même temps) sont équilibrés, false sinon
+     */
+    bool DictionnaireReparti::estEquilibre() const
+    {
+        std::vector<std::shared_lock<std::shared_mutex> > verrous = _verrouilleLecture();
+        for (std::size_t f = 0; f < fragments.size(); f++)
+        {
+            if (!fragments[f]->dictionnaire.estEquilibre()) return false;
+        }
+        return true;
+    }
+
+    /**
+     * \fn unsigned int DictionnaireReparti::nbFragments() const
+     * \brief Retourne le nombre de fragments
+     * \return Le nombre de fragments
+     */
+    unsigned int DictionnaireReparti::nbFragments() const
+    {
+        return fragments.size();
+    }
+
+    /**
+     * \fn unsigned int DictionnaireReparti::fragmentDe(std::string_view mot) const
+     * \brief Retourne l'indice du fragment d'un mot, selon son hachage
+     * \param[in] mot Le mot
+     * \return Un indice entre 0 et nbFragments() - 1
+     */
+    unsigned int DictionnaireReparti::fragmentDe(std::string_view mot) const
+    {
+        return std::hash<std::string_view>()(mot) % fragments.size();
+    }
+
+    /**
+     * \fn void DictionnaireReparti::demarreEcrivains(bool epingleCoeurs)
+     * \brief Démarre un thread écrivain par fragment
+     * \param[in] epingleCoeurs Sous Linux, fixe l'écrivain du fragment f au coeur f % (nombre de coeurs)
+     * \post Les écritures planifiées d'un fragment sont appliquées par son écrivain, et seulement par lui
+     * \post L'état de chaque écrivain n'est lu et modifié que sous le verrou de la file de son fragment
+     */
+    void DictionnaireReparti::demarreEcrivains(bool epingleCoeurs)
+    {
+        unsigned int nbCoeurs = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t f = 0; f < fragments.size(); f++)
+        {
+            Fragment &fragment = *fragments[f];
+            std::lock_guard<std::mutex> verrou(fragment.verrouFile);
+            if (fragment.enFonction) continue; // Déjà démarré, ou l'écrivain arrêté n'a pas fini sa file
+            fragment.actif = true;
+            fragment.enFonction = true;
+            fragment.arret = false;
+            fragment.ecrivain = std::thread(_ecrit, std::ref(fragment));
+#if defined(__linux__)
+            if (epingleCoeurs)
+            {
+                cpu_set_t coeurs;
+                CPU_ZERO(&coeurs);
+                CPU_SET(f % nbCoeurs, &coeurs);
+                pthread_setaffinity_np(fragment.ecrivain.native_handle(), sizeof(coeurs), &coeurs);
+            }
+#else
+            (void)epingleCoeurs;
+            (void)nbCoeurs;
+#endif
+        }
+    }
+
+    /**
+     * \fn void DictionnaireReparti::arreteEcrivains()
+     * \brief Arrête les threads écrivains
+     * \post Toutes les écritures planifiées avant l'appel sont appliquées. Les suivantes sont refusées
+     */
+    void DictionnaireReparti::arreteEcrivains()
+    {
+        std::vector<std::thread> ecrivains;
+        for (std::size_t f = 0; f < fragments.size(); f++)
+        {
+            Fragment &fragment = *fragments[f];
+            {
+                std::lock_guard<std::mutex> verrou(fragment.verrouFile);
+                if (!fragment.actif) continue;
+                fragment.actif = false;
+                fragment.arret = true;
+                ecrivains.push_back(std::move(fragment.ecrivain)); // Un seul appelant attend chaque écrivain
+            }
+            fragment.nouvelles.notify_one();
+        }
+        for (std::size_t t = 0; t < ecrivains.size(); t++) ecrivains[t].join();
+    }
+
+    /**
+     * \fn void DictionnaireReparti::planifieAjout(std::string motOriginal, std::string motTraduit)
+     * \brief Planifie l'ajout d'un mot et de l'une de ses traductions par l'écrivain de son fragment
+     * \param[in] motOriginal Le mot original
+     * \param[in] motTraduit Le mot traduit
+     * \exception logic_error Si les écrivains ne sont pas démarrés
+     */
+    void DictionnaireReparti::planifieAjout(std::string motOriginal, std::string motTraduit)
+    {
+        _planifie(EcriturePlanifiee{ true, std::move(motOriginal), std::move(motTraduit) });
+    }
+
+    /**
+     * \fn void DictionnaireReparti::planifieSuppression(std::string motOriginal)
+     * \brief Planifie la suppression d'un mot par l'écrivain de son fragment
+     * \param[in] motOriginal Le mot à supprimer (ignoré s'il est absent au moment de l'appliquer)
+     * \exception logic_error Si les écrivains ne sont pas démarrés
+     */
+    void DictionnaireReparti::planifieSuppression(std::string motOriginal)
+    {
+        _planifie(EcriturePlanifiee{ false, std::move(motOriginal), std::string() });
+    }
+
+    /**
+     * \fn void DictionnaireReparti::attendEcritures()
+     * \brief Attend que toutes les écritures planifiées jusqu'ici soient appliquées
+     * \post Les lectures suivantes voient toutes ces écritures
+     */
+    void DictionnaireReparti::attendEcritures()
+    {
+        for (std::size_t f = 0; f < fragments.size(); f++)
+        {
+            Fragment &fragment = *fragments[f];
+            std::unique_lock<std::mutex> verrou(fragment.verrouFile);
+            fragment.appliquees.wait(verrou, [&]() { return fragment.file.empty() && fragment.nbEnCours == 0; });
+        }
+    }
+
+    /**
+     * \fn void DictionnaireReparti::_planifie(EcriturePlanifiee ecriture)
+     * \brief Méthode auxiliaire aux écrivains pour mettre une écriture dans la file de son fragment
+     * \param[in] ecriture L'écriture
+     * \exception logic_error Si l'écrivain du fragment n'est pas démarré (ou est arrêté)
+     */
+    void DictionnaireReparti::_planifie(EcriturePlanifiee ecriture)
+    {
+        Fragment &fragment = *fragments[fragmentDe(ecriture.mot)];
+        {
+            std::lock_guard<std::mutex> verrou(fragment.verrouFile);
+            if (!fragment.actif) throw std::logic_error("Les écrivains ne sont pas démarrés");
+            fragment.file.push_back(std::move(ecriture));
+        }
+        fragment.nouvelles.notify_one();
+    }
+
+    /**
+     * \fn void DictionnaireReparti::_ecrit(Fragment &fragment)
+     * \brief Boucle du thread écrivain d'un fragment
+     * \param[in] fragment Le fragment
+     * \post Chaque tour prend toute la file d'un coup et l'applique sous une seule prise du verrou exclusif
+     * \post Termine quand l'arrêt est demandé et que la file est vide
+     */
+    void DictionnaireReparti::_ecrit(Fragment &fragment)
+    {
+        std::vector<EcriturePlanifiee> lot;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> verrou(fragment.verrouFile);
+                fragment.nouvelles.wait(verrou, [&]() { return !fragment.file.empty() || fragment.arret; });
+                if (fragment.file.empty()) // Arrêt demandé, tout est appliqué
+                {
+                    fragment.enFonction = false;
+                    return;
+                }
+                lot.swap(fragment.file);
+                fragment.nbEnCours = lot.size();
+            }
+
+            {
+                std::unique_lock<std::shared_mutex> verrou(fragment.verrou);
+                for (std::size_t i = 0; i < lot.size(); i++)
+                {
+                    if (lot[i].ajout) fragment.dictionnaire.ajouteMot(std::move(lot[i].mot), std::move(lot[i].traduction));
+                    else if (fragment.dictionnaire.appartient(lot[i].mot)) fragment.dictionnaire.supprimeMot(lot[i].mot);
+                }
+            }
+            lot.clear();
+
+            {
+                std::lock_guard<std::mutex> verrou(fragment.verrouFile);
+                fragment.nbEnCours = 0;
+            }
+            fragment.appliquees.notify_all();
+        }
+    }
+
+    /**
+     * \fn std::vector<std::shared_lock<std::shared_mutex> > DictionnaireReparti::_verrouilleLecture() const
+     * \brief Méthode auxiliaire aux lectures de plusieurs fragments pour les verrouiller tous en lecture
+     * \return Les verrous, pris dans l'ordre des indices. Ils sont relâchés quand le vecteur est détruit
+     * \post Aucun lot de appliqueDelta n'est à moitié visible tant que les verrous sont gardés
+     */
+    std::vector<std::shared_lock<std::shared_mutex> > DictionnaireReparti::_verrouilleLecture() const
+    {
+        std::vector<std::shared_lock<std::shared_mutex> > verrous;
+        verrous.reserve(fragments.size());
+        for (std::size_t f = 0; f < fragments.size(); f++) verrous.emplace_back(fragments[f]->verrou);
+        return verrous;
+    }
+
+    /**
+     * \fn void DictionnaireReparti::_creeFragments(unsigned int nbFragments)
+     * \brief Méthode auxiliaire aux constructeurs pour créer les fragments vides
+     * \param[in] nbFragments Le nombre de fragments (0 est traité comme 1)
+     */
+    void DictionnaireReparti::_creeFragments(unsigned int nbFragments)
+    {
+        if (nbFragments == 0) nbFragments = 1;
+        for (unsigned int f = 0; f < nbFragments; f++)
+        {
+            fragments.push_back(std::unique_ptr<Fragment>(new Fragment()));
+        }
+    }
+
+}//Fin du namespace
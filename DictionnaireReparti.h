@@ -0,0 +1,162 @@
+/**
+ * \file DictionnaireReparti.h
+ * \brief Ce fichier contient l'interface d'un dictionnaire réparti en plusieurs fragments indépendants.
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef DICO_REPARTI_H_
+#define DICO_REPARTI_H_
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include "Dictionnaire.h"
+
+namespace TP3
+{
+
+//classe représentant un dictionnaire réparti en K arbres AVL indépendants (fragments),
+//chacun protégé par son propre verrou. Un mot appartient toujours au même fragment (selon son hachage),
+//si bien que des écritures sur des fragments différents peuvent se faire en parallèle.
+//Les écritures d'un fragment peuvent aussi être épinglées à un thread écrivain qui lui est propre
+//(voir demarreEcrivains) : elles sont alors mises en file et appliquées par lots par ce thread.
+//Allocation : les fragments n'ont PAS d'allocateur propre. Leurs noeuds et leurs chaînes viennent de
+//l'allocateur global (new, std::string), comme ceux de Dictionnaire, et un fragment peut donc partager
+//des pages avec les autres. Seuls les écrivains épinglés rapprochent les allocations d'un fragment (voir
+//demarreEcrivains), sans le garantir : les ajouts directs (ajouteMot, ajouteMots, appliqueDelta)
+//allouent dans le thread appelant.
+class DictionnaireReparti
+{
+public:
+
+	//Constructeur d'un dictionnaire vide de nbFragments fragments (au moins 1)
+	explicit DictionnaireReparti(unsigned int nbFragments);
+
+	//Constructeur de dictionnaire à partir d'un fichier, réparti en nbFragments fragments
+	//Le fichier doit être ouvert au préalable
+	DictionnaireReparti(std::ifstream &fichier, unsigned int nbFragments);
+
+	//Destructeur. Les écrivains sont arrêtés après avoir appliqué leurs files
+	~DictionnaireReparti();
+
+	//Ajouter un mot au dictionnaire et l'une de ses traductions (dans le fragment du mot)
+	//(const std::string& pour copier, std::string&& pour déplacer les chaînes dans le noeud)
+	void ajouteMot(const std::string &motOriginal, const std::string &motTraduit);
+	void ajouteMot(std::string &&motOriginal, std::string &&motTraduit);
+
+	//Ajouter un lot de paires (mot, traduction). Les paires sont regroupées par fragment
+	//et chaque fragment est rempli par son propre thread. Un lot passé en rvalue voit ses chaînes déplacées.
+	void ajouteMots(const std::vector<std::pair<std::string, std::string> > &mots);
+	void ajouteMots(std::vector<std::pair<std::string, std::string> > &&mots);
+
+	//Appliquer un fichier de modifications (delta, voir Dictionnaire::appliqueDelta) en un seul lot.
+	//Le fichier est validé en entier, puis chaque fragment reçoit ses opérations pendant que tous les fragments
+	//sont verrouillés en exclusif. Les lectures d'un mot ne voient donc que le fragment avant ou après le lot,
+	//et les lectures qui touchent plusieurs fragments (suggereCorrections, taille, estVide, estEquilibre)
+	//verrouillent tous les fragments en lecture : chacune voit tout le lot ou rien.
+	//Exception	logic_error si une ligne est mal formée (rien n'est alors appliqué)
+	void appliqueDelta(std::ifstream &fichier);
+
+	//Supprimer un mot (dans son fragment)
+	//Exception	logic_error si le mot n'appartient pas au dictionnaire
+	void supprimeMot(std::string_view motOriginal);
+
+	//Suggère jusqu'à 5 corrections, comme Dictionnaire::suggereCorrections.
+	//Tous les fragments sont verrouillés en lecture, parcourus en parallèle, puis les listes sont fusionnées.
+	std::vector<std::string> suggereCorrections(std::string_view motMalEcrit);
+
+	//Trouver les traductions possibles d'un mot (vecteur vide si le mot est absent)
+	std::vector<std::string> traduit(std::string_view mot);
+
+	//Vérifier si le mot donné appartient au dictionnaire
+	bool appartient(std::string_view mot);
+
+	//Vérifier si le dictionnaire est vide
+	bool estVide() const;
+
+	//Retourner le nombre de mots dans le dictionnaire (tous fragments confondus, verrouillés ensemble)
+	unsigned int taille() const;
+
+	//Vérifier si tous les arbres AVL sous-jacents sont équilibrés
+	bool estEquilibre() const;
+
+	//Retourner le nombre de fragments
+	unsigned int nbFragments() const;
+
+	//Retourner l'indice du fragment qui contient (ou contiendra) un mot.
+	unsigned int fragmentDe(std::string_view mot) const;
+
+	//Démarrer un thread écrivain par fragment. Sous Linux, l'écrivain du fragment f est aussi fixé
+	//au coeur f % (nombre de coeurs) si epingleCoeurs est vrai. Les noeuds ajoutés par les écritures
+	//planifiées d'un fragment sont alors alloués par un même thread (avec glibc, dans l'arène de malloc de ce
+	//thread, ce qui est un comportement de glibc et non une garantie de cette classe).
+	//Sans effet sur un fragment dont l'écrivain est déjà démarré (ou pas encore terminé après un arrêt)
+	void demarreEcrivains(bool epingleCoeurs = true);
+
+	//Arrêter les threads écrivains, après qu'ils ont appliqué toutes les écritures planifiées.
+	//Une écriture planifiée en même temps est soit appliquée, soit refusée (logic_error), jamais perdue
+	void arreteEcrivains();
+
+	//Planifier un ajout ou une suppression dans la file de l'écrivain du fragment du mot, sans attendre.
+	//Les écritures d'un même fragment sont appliquées dans l'ordre où elles ont été planifiées.
+	//La suppression d'un mot absent est ignorée.
+	//Exception	logic_error si les écrivains ne sont pas démarrés
+	void planifieAjout(std::string motOriginal, std::string motTraduit);
+	void planifieSuppression(std::string motOriginal);
+
+	//Attendre que toutes les écritures planifiées jusqu'ici soient appliquées
+	void attendEcritures();
+
+private:
+
+	// Une écriture planifiée pour l'écrivain d'un fragment
+	struct EcriturePlanifiee
+	{
+		bool ajout;				// true pour un ajout, false pour une suppression
+		std::string mot;
+		std::string traduction;			// Vide pour une suppression
+	};
+
+	// Un fragment : un dictionnaire et le verrou lecteurs/écrivain qui le protège,
+	// puis la file de son thread écrivain (s'il est démarré)
+	struct Fragment
+	{
+		Dictionnaire dictionnaire;
+		mutable std::shared_mutex verrou;
+
+		std::mutex verrouFile;			// Protège file, nbEnCours, actif, enFonction, arret et ecrivain
+		std::condition_variable nouvelles;	// Signalée quand la file reçoit une écriture (ou à l'arrêt)
+		std::condition_variable appliquees;	// Signalée quand l'écrivain a vidé la file
+		std::vector<EcriturePlanifiee> file;	// Les écritures en attente
+		std::size_t nbEnCours = 0;		// Les écritures retirées de la file mais pas encore appliquées
+		bool actif = false;			// L'écrivain accepte-t-il des écritures ?
+		bool enFonction = false;		// Le thread écrivain tourne-t-il encore ? (il le remet à false en terminant)
+		bool arret = false;			// L'écrivain doit terminer après avoir vidé la file
+		std::thread ecrivain;
+	};
+
+	std::vector<std::unique_ptr<Fragment> > fragments;	// Les fragments, indexés par fragmentDe
+
+	// Méthode auxiliaire aux constructeurs pour créer les fragments vides
+	void _creeFragments(unsigned int nbFragments);
+
+	// Méthode auxiliaire aux lectures de plusieurs fragments pour les verrouiller tous en lecture,
+	// dans l'ordre des indices (le même ordre que appliqueDelta, pour éviter l'interblocage)
+	std::vector<std::shared_lock<std::shared_mutex> > _verrouilleLecture() const;
+
+	// Méthodes auxiliaires aux écrivains
+	void _planifie(EcriturePlanifiee ecriture);
+	static void _ecrit(Fragment &fragment);
+};
+
+}
+
+#endif /* DICO_REPARTI_H_ */
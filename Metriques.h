@@ -0,0 +1,174 @@
+/**
+ * \file Metriques.h
+ * \brief Ce fichier contient les métriques de similitude entre mots utilisées pour suggérer des corrections.
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Chaque métrique est une politique (une structure sans état) : ses coûts sont des constantes entières
+ * (ou une table générée à la compilation) et son seuil de suggestion est une constante. Le calcul de
+ * distance est un gabarit instancié pour chaque politique : les coûts y sont connus à la compilation
+ * et la boucle interne n'a ni appel indirect ni test de métrique.
+ */
+
+
+#ifndef METRIQUES_H_
+#define METRIQUES_H_
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+namespace TP3
+{
+
+// Les métriques de similitude disponibles (voir Dictionnaire::choisitMetrique)
+enum Metrique
+{
+	LEVENSHTEIN,		// Insertion, suppression, substitution : coût 1
+	DAMERAU_LEVENSHTEIN,	// Comme LEVENSHTEIN, plus la transposition de deux lettres voisines : coût 1
+	CLAVIER_QWERTY		// Comme DAMERAU_LEVENSHTEIN, mais substituer deux touches voisines coûte 1/2
+};
+
+namespace Metriques
+{
+
+// Les coûts sont des entiers : 1 opération complète = ECHELLE (une puissance de 2, pour que
+// la similitude de LEVENSHTEIN soit exactement celle du calcul à coûts unitaires)
+const unsigned int ECHELLE = 4;
+
+// Longueur de mot jusqu'à laquelle les rangées du calcul sont sur la pile
+const std::size_t LONGUEUR_PILE = 64;
+
+// Table des coûts de substitution entre caractères ASCII
+struct TableCouts
+{
+	unsigned char couts[128][128];
+};
+
+// Génère (à la compilation) la table des substitutions sur un clavier QWERTY :
+// 0 pour la même lettre, ECHELLE / 2 pour deux touches voisines, ECHELLE sinon
+constexpr TableCouts genereTableQwerty()
+{
+	const char *rangees[3] = { "qwertyuiop", "asdfghjkl", "zxcvbnm" };
+	TableCouts table = {};
+	for (unsigned int a = 0; a < 128; a++)
+		for (unsigned int b = 0; b < 128; b++) table.couts[a][b] = (a == b) ? 0 : ECHELLE;
+
+	for (int r = 0; r < 3; r++)
+	{
+		for (int c = 0; rangees[r][c] != '\0'; c++)
+		{
+			unsigned char touche = rangees[r][c];
+			// Voisine de droite sur la même rangée
+			if (rangees[r][c + 1] != '\0')
+			{
+				unsigned char droite = rangees[r][c + 1];
+				table.couts[touche][droite] = table.couts[droite][touche] = ECHELLE / 2;
+			}
+			// Rangée du dessous, décalée d'une demi-touche vers la droite : colonnes c - 1 et c
+			if (r < 2)
+			{
+				for (int d = c - 1; d <= c; d++)
+				{
+					int longueur = 0;
+					while (rangees[r + 1][longueur] != '\0') longueur++;
+					if (d < 0 || d >= longueur) continue;
+					unsigned char dessous = rangees[r + 1][d];
+					table.couts[touche][dessous] = table.couts[dessous][touche] = ECHELLE / 2;
+				}
+			}
+		}
+	}
+	return table;
+}
+
+// Distance de Levenshtein : insertion, suppression et substitution coûtent une opération
+struct Levenshtein
+{
+	static constexpr bool TRANSPOSITIONS = false;
+	static constexpr unsigned int INSERTION = ECHELLE;
+	static constexpr unsigned int SUPPRESSION = ECHELLE;
+	static constexpr unsigned int TRANSPOSITION = ECHELLE;
+	static constexpr double SEUIL = 0.6;	// Similitude minimale d'une suggestion
+
+	static constexpr unsigned int substitution(unsigned char a, unsigned char b)
+	{
+		return (a == b) ? 0 : ECHELLE;
+	}
+};
+
+// Distance de Damerau-Levenshtein (restreinte) : la transposition de deux lettres voisines coûte une opération
+struct DamerauLevenshtein : Levenshtein
+{
+	static constexpr bool TRANSPOSITIONS = true;
+};
+
+// Comme DamerauLevenshtein, mais une substitution entre touches voisines d'un clavier QWERTY coûte une demi-opération
+struct ClavierQwerty : DamerauLevenshtein
+{
+	static constexpr TableCouts TABLE = genereTableQwerty();
+
+	static constexpr unsigned int substitution(unsigned char a, unsigned char b)
+	{
+		return (a < 128 && b < 128) ? TABLE.couts[a][b] : ((a == b) ? 0 : ECHELLE);
+	}
+};
+
+// Distance entre deux mots selon la métrique M (en unités de 1 / ECHELLE opération)
+// Seules trois rangées de la matrice de programmation dynamique sont gardées, sur la pile si le mot 2 est court.
+template <typename M>
+unsigned int distance(std::string_view mot1, std::string_view mot2)
+{
+	const std::size_t len1 = mot1.size(), len2 = mot2.size();
+
+	unsigned int pile[3][LONGUEUR_PILE + 1];
+	std::vector<unsigned int> tas;
+	unsigned int *avantDerniere = pile[0], *derniere = pile[1], *courante = pile[2];
+	if (len2 > LONGUEUR_PILE)
+	{
+		tas.resize(3 * (len2 + 1));
+		avantDerniere = tas.data();
+		derniere = avantDerniere + len2 + 1;
+		courante = derniere + len2 + 1;
+	}
+
+	for (std::size_t j = 0; j <= len2; j++) derniere[j] = j * M::INSERTION;
+	for (std::size_t i = 1; i <= len1; i++)
+	{
+		const unsigned char a = mot1[i - 1];
+		courante[0] = i * M::SUPPRESSION;
+		for (std::size_t j = 1; j <= len2; j++)
+		{
+			const unsigned char b = mot2[j - 1];
+			unsigned int cout = std::min({ derniere[j] + M::SUPPRESSION, courante[j - 1] + M::INSERTION,
+			                               derniere[j - 1] + M::substitution(a, b) });
+			if (M::TRANSPOSITIONS && i > 1 && j > 1 && a == static_cast<unsigned char>(mot2[j - 2])
+			    && static_cast<unsigned char>(mot1[i - 2]) == b)
+			{
+				cout = std::min(cout, avantDerniere[j - 2] + M::TRANSPOSITION);
+			}
+			courante[j] = cout;
+		}
+		unsigned int *libre = avantDerniere;
+		avantDerniere = derniere;
+		derniere = courante;
+		courante = libre;
+	}
+	return derniere[len2];
+}
+
+// Similitude entre deux mots selon la métrique M : 1 - distance / (longueur du plus long mot)
+// 1 : mots identiques, 0 (ou moins) : mots complètement différents
+template <typename M>
+double similitude(std::string_view mot1, std::string_view mot2)
+{
+	std::size_t maxlen = std::max(mot1.size(), mot2.size());
+	if (maxlen == 0) return 1.0;
+	return 1.0 - (double)distance<M>(mot1, mot2) / (double)(maxlen * ECHELLE);
+}
+
+}
+}
+
+#endif /* METRIQUES_H_ */
@@ -10,7 +10,12 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
 #include "Dictionnaire.h"
+#include "Tokeniseur.h"
 
 using namespace std;
 using namespace TP3;
@@ -49,6 +54,76 @@ size_t afficheListeChoix(const vector<string> &listeChoix)
 	else return choix - 1;
 }
 
+/**
+ * \brief Ce qu'il faut savoir d'un mot de la phrase avant de questionner l'utilisateur :
+ * ses traductions ou, s'il est absent, les suggestions de correction et leurs traductions.
+ */
+struct ResolutionMot
+{
+	vector<string> traductions;
+	vector<string> suggestions;
+	vector<vector<string> > traductionsSuggestions;
+};
+
+/**
+ * \brief Cherche les traductions d'un mot et, s'il est absent, les suggestions et leurs traductions.
+ * Ne fait que lire le dictionnaire : plusieurs appels peuvent se faire en même temps.
+ * \param[in] dictionnaire Le dictionnaire
+ * \param[in] mot Le mot anglais
+ * \return La résolution du mot
+ */
+ResolutionMot resoutMot(Dictionnaire &dictionnaire, string_view mot)
+{
+	ResolutionMot resolution;
+	resolution.traductions = dictionnaire.traduit(mot);
+	if (resolution.traductions.empty())
+	{
+		resolution.suggestions = dictionnaire.suggereCorrections(mot);
+		for (size_t s = 0; s < resolution.suggestions.size(); s++)
+			resolution.traductionsSuggestions.push_back(dictionnaire.traduit(resolution.suggestions[s]));
+	}
+	return resolution;
+}
+
+/**
+ * \brief Lance la résolution de tous les mots d'une phrase en arrière-plan.
+ * Quelques threads prennent les mots dans l'ordre de la phrase : le premier mot est prêt en premier,
+ * et les suivants se calculent pendant que l'utilisateur répond aux questions sur les précédents.
+ * \param[in] dictionnaire Le dictionnaire (qui ne doit pas être modifié pendant la résolution)
+ * \param[in] mots Les mots anglais de la phrase (qui doivent exister jusqu'à la fin de la résolution)
+ * \param[out] resolutions Une future par mot, dans l'ordre de la phrase
+ * \return Les threads de résolution, à attendre avant de détruire le dictionnaire ou les mots
+ */
+vector<future<void> > lanceResolutions(Dictionnaire &dictionnaire, const vector<string_view> &mots,
+                                       vector<future<ResolutionMot> > &resolutions)
+{
+	shared_ptr<vector<promise<ResolutionMot> > > promesses = make_shared<vector<promise<ResolutionMot> > >(mots.size());
+	resolutions.clear();
+	for (size_t k = 0; k < mots.size(); k++) resolutions.push_back((*promesses)[k].get_future());
+
+	shared_ptr<atomic<size_t> > prochain = make_shared<atomic<size_t> >(0);
+	size_t nbThreads = min<size_t>(max(1u, thread::hardware_concurrency()), mots.size());
+	vector<future<void> > threads;
+	for (size_t t = 0; t < nbThreads; t++)
+	{
+		threads.push_back(async(launch::async, [&dictionnaire, &mots, promesses, prochain]()
+		{
+			for (size_t k = (*prochain)++; k < mots.size(); k = (*prochain)++)
+			{
+				try
+				{
+					(*promesses)[k].set_value(resoutMot(dictionnaire, mots[k]));
+				}
+				catch (...)
+				{
+					(*promesses)[k].set_exception(current_exception());
+				}
+			}
+		}));
+	}
+	return threads;
+}
+
 /**
  * \brief Fonction principale du programme. Charge le dictionnaire et permet à l'utilisateur de traduire une phrase.
  * \return 0 si le programme s'est terminé normalement, 1 sinon.
@@ -95,43 +170,45 @@ int main()
 		cout << "Nombre de mots : " << dictEnFr.taille() << endl;
 		cout << endl;
 
-		vector<string> motsAnglais; //Vecteur qui contiendra les mots anglais de la phrase entrée
+		vector<string_view> motsAnglais; //Vecteur qui contiendra les mots anglais de la phrase entrée
 
 		//Lecture de la phrase en anglais
-		cout << "Entrez un texte en anglais (pas de majuscules ou de ponctuation/caracteres speciaux):" << endl;
+		cout << "Entrez un texte en anglais :" << endl;
 		getline(cin, reponse);
 
-		stringstream reponse_ss(reponse);
-		string str_temp;
-
-		//On ajoute un mot au vecteur de mots tant qu'on en trouve dans la phrase (séparateur = espace)
-		while (reponse_ss >> str_temp)
-		{
-			motsAnglais.push_back(str_temp);
-		}
+		//Le texte brut est normalisé (minuscules, sans accents) et découpé en mots
+		//(séparateurs = espaces, chiffres et ponctuation). Les mots sont des vues dans le tampon
+		//du tokeniseur, passées telles quelles au dictionnaire : aucune chaîne n'est copiée
+		Tokeniseur tokeniseur;
+		motsAnglais = tokeniseur.decoupe(reponse);
 
 		vector<string> motsFrancais; //Vecteur qui contiendra les mots traduits en français
 
-		for (vector<string>::iterator i = motsAnglais.begin(); i != motsAnglais.end(); i++)
+		//Tous les mots sont résolus en arrière-plan dès maintenant : les choix de chaque question
+		//sont en général déjà calculés quand on y arrive
+		vector<future<ResolutionMot> > resolutions;
+		vector<future<void> > threadsResolution = lanceResolutions(dictEnFr, motsAnglais, resolutions);
+
+		for (size_t k = 0; k < motsAnglais.size(); k++)
 			// Itération dans les mots anglais de la phrase donnée
-			// CHOIX ETUDIANT: j'ai changé le const_iterator en iterator pour pouvoir modifier le vecteur
-			// de mots anglais en cas de correction de mot
 		{
 			// À compléter ...
 			// _________________________________
 			// CODE ETUDIANT
 			// _________________________________
 			
-			vector<string> traductions = dictEnFr.traduit(*i);
+			ResolutionMot resolution = resolutions[k].get();
+			vector<string> &traductions = resolution.traductions;
+			string_view motAnglais = motsAnglais[k];
 			
 			if (traductions.size() == 0) 
 			{
 				// On commence par essayer de ramener le mot à l'un de ceux du dictionnaire
-				vector<string> suggestions = dictEnFr.suggereCorrections(*i);
+				vector<string> &suggestions = resolution.suggestions;
 				if (suggestions.size() == 0)
 				{
 					// Le mot n'existe pas dans le dictionnaire, et aucune suggestion n'a été trouvée
-					cout << "Le mot '" << *i << "' n'existe pas dans le dictionnaire. Veuillez entrer manuellement un mot de remplacement (ENTER pour ignorer):" << endl;
+					cout << "Le mot '" << motAnglais << "' n'existe pas dans le dictionnaire. Veuillez entrer manuellement un mot de remplacement (ENTER pour ignorer):" << endl;
 					cout << "Votre choix : ";
 					getline(cin, reponse);
 					motsFrancais.push_back(reponse);
@@ -139,10 +216,10 @@ int main()
 				else
 				{
 					// Le mot n'existe pas dans le dictionnaire, mais des suggestions ont été trouvées
-					cout << "Le mot '" << *i << "' n'existe pas dans le dictionnaire. Veuillez choisir une des suggestions suivantes :" << endl;
+					cout << "Le mot '" << motAnglais << "' n'existe pas dans le dictionnaire. Veuillez choisir une des suggestions suivantes :" << endl;
 					size_t choix = afficheListeChoix(suggestions);
-					*i = suggestions[choix];
-					traductions = dictEnFr.traduit(*i);
+					motAnglais = suggestions[choix];
+					traductions = resolution.traductionsSuggestions[choix];
 				}
 			}
 
@@ -154,7 +231,7 @@ int main()
 			else if (traductions.size() > 1)
 			{
 				// Plusieurs traductions possibles
-				cout << "Plusieurs traductions sont possibles pour le mot '" << *i << "'. Veuillez en choisir une parmi les suivantes: " << endl;
+				cout << "Plusieurs traductions sont possibles pour le mot '" << motAnglais << "'. Veuillez en choisir une parmi les suivantes: " << endl;
 				size_t choix = afficheListeChoix(traductions);
 				motsFrancais.push_back(traductions[choix]);
 			}
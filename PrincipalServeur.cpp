@@ -0,0 +1,75 @@
+/**
+ * \file PrincipalServeur.cpp
+ * \brief Service de traduction : charge le dictionnaire une seule fois et répond aux requêtes (voir Protocole.h)
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include <csignal>
+#include <iostream>
+#include <fstream>
+#include "Dictionnaire.h"
+#include "ServeurTraduction.h"
+
+using namespace std;
+using namespace TP3;
+
+// Le serveur à arrêter lors d'un SIGINT ou d'un SIGTERM
+static ServeurTraduction *serveurActif = nullptr;
+
+/**
+ * \brief Gestionnaire de SIGINT et SIGTERM : demande l'arrêt du serveur (le signal reçu n'est pas utilisé)
+ */
+static void arreteServeur(int)
+{
+	if (serveurActif != nullptr) serveurActif->arrete();
+}
+
+/**
+ * \brief Fonction principale du service. Charge le dictionnaire puis sert les requêtes jusqu'à SIGINT ou SIGTERM.
+ * \return 0 si le programme s'est terminé normalement, 1 sinon.
+ */
+int main(int argc, char *argv[])
+{
+	if (argc != 3)
+	{
+		cerr << "Usage : " << argv[0] << " <fichier du dictionnaire> <port | chemin de socket Unix>" << endl;
+		return 1;
+	}
+
+	try
+	{
+		ifstream englishFrench(argv[1]);
+		if (!englishFrench)
+		{
+			cerr << "Fichier '" << argv[1] << "' introuvable!" << endl;
+			return 1;
+		}
+		Dictionnaire dictEnFr(englishFrench);
+		englishFrench.close();
+		cout << "Dictionnaire chargé : " << dictEnFr.taille() << " mots" << endl;
+
+		ServeurTraduction serveur(dictEnFr, argv[2]);
+		serveurActif = &serveur;
+
+		// Pas de SA_RESTART : le signal interrompt epoll_wait et la boucle voit la demande d'arrêt
+		struct sigaction action = {};
+		action.sa_handler = arreteServeur;
+		sigaction(SIGINT, &action, nullptr);
+		sigaction(SIGTERM, &action, nullptr);
+
+		cout << "En écoute sur " << argv[2] << endl;
+		serveur.execute();
+		serveurActif = nullptr;
+		cout << "Arrêt après " << serveur.nbRequetes() << " requêtes" << endl;
+	}
+	catch (exception & e)
+	{
+		cerr << e.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,306 @@
+/**
+ * \file Protocole.cpp
+ * \brief Ce fichier contient une implantation des fonctions du protocole du service de traduction
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "Protocole.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace TP3
+{
+namespace Protocole
+{
+    /**
+     * \fn void ajouteU16(std::string &tampon, std::uint16_t valeur)
+     * \brief Ajoute à un tampon un entier de 16 bits en ordre réseau
+     * \param[in] tampon Le tampon
+     * \param[in] valeur L'entier
+     */
+    void ajouteU16(std::string &tampon, std::uint16_t valeur)
+    {
+        tampon.push_back(static_cast<char>(valeur >> 8));
+        tampon.push_back(static_cast<char>(valeur));
+    }
+
+    /**
+     * \fn void ajouteU32(std::string &tampon, std::uint32_t valeur)
+     * \brief Ajoute à un tampon un entier de 32 bits en ordre réseau
+     * \param[in] tampon Le tampon
+     * \param[in] valeur L'entier
+     */
+    void ajouteU32(std::string &tampon, std::uint32_t valeur)
+    {
+        ajouteU16(tampon, static_cast<std::uint16_t>(valeur >> 16));
+        ajouteU16(tampon, static_cast<std::uint16_t>(valeur));
+    }
+
+    /**
+     * \fn std::uint16_t lisU16(const char *octets)
+     * \brief Lit un entier de 16 bits en ordre réseau
+     * \param[in] octets Les 2 octets à lire
+     * \return L'entier lu
+     */
+    std::uint16_t lisU16(const char *octets)
+    {
+        const unsigned char *o = reinterpret_cast<const unsigned char*>(octets);
+        return static_cast<std::uint16_t>((o[0] << 8) | o[1]);
+    }
+
+    /**
+     * \fn std::uint32_t lisU32(const char *octets)
+     * \brief Lit un entier de 32 bits en ordre réseau
+     * \param[in] octets Les 4 octets à lire
+     * \return L'entier lu
+     */
+    std::uint32_t lisU32(const char *octets)
+    {
+        return (static_cast<std::uint32_t>(lisU16(octets)) << 16) | lisU16(octets + 2);
+    }
+
+    /**
+     * \fn void ajouteRequete(std::string &tampon, Operation operation, const std::string &mot)
+     * \brief Ajoute à un tampon une requête complète
+     * \param[in] tampon Le tampon
+     * \param[in] operation L'opération demandée
+     * \param[in] mot Le mot visé
+     */
+    void ajouteRequete(std::string &tampon, Operation operation, const std::string &mot)
+    {
+        ajouteU32(tampon, static_cast<std::uint32_t>(1 + mot.size()));
+        tampon.push_back(static_cast<char>(operation));
+        tampon += mot;
+    }
+
+    /**
+     * \fn void ajouteReponseListe(std::string &tampon, const std::vector<std::string> &chaines)
+     * \brief Ajoute à un tampon une réponse contenant une liste de chaînes
+     * \param[in] tampon Le tampon
+     * \param[in] chaines Les chaînes (chacune tronquée à 65535 octets)
+     */
+    void ajouteReponseListe(std::string &tampon, const std::vector<std::string> &chaines)
+    {
+        std::size_t debut = tampon.size();
+        ajouteU32(tampon, 0); // La longueur est écrite à la fin
+        tampon.push_back(static_cast<char>(OK));
+        ajouteU16(tampon, static_cast<std::uint16_t>(chaines.size()));
+        for (std::size_t i = 0; i < chaines.size(); i++)
+        {
+            std::uint16_t longueur = static_cast<std::uint16_t>(std::min<std::size_t>(chaines[i].size(), 0xFFFF));
+            ajouteU16(tampon, longueur);
+            tampon.append(chaines[i], 0, longueur);
+        }
+
+        std::string longueur;
+        ajouteU32(longueur, static_cast<std::uint32_t>(tampon.size() - debut - 4));
+        tampon.replace(debut, 4, longueur);
+    }
+
+    /**
+     * \fn void ajouteReponseBooleen(std::string &tampon, bool valeur)
+     * \brief Ajoute à un tampon une réponse contenant un booléen
+     * \param[in] tampon Le tampon
+     * \param[in] valeur Le booléen
+     */
+    void ajouteReponseBooleen(std::string &tampon, bool valeur)
+    {
+        ajouteU32(tampon, 2);
+        tampon.push_back(static_cast<char>(OK));
+        tampon.push_back(valeur ? 1 : 0);
+    }
+
+    /**
+     * \fn void ajouteReponseErreur(std::string &tampon, const std::string &message)
+     * \brief Ajoute à un tampon une réponse d'erreur
+     * \param[in] tampon Le tampon
+     * \param[in] message Le message d'erreur
+     */
+    void ajouteReponseErreur(std::string &tampon, const std::string &message)
+    {
+        ajouteU32(tampon, static_cast<std::uint32_t>(1 + message.size()));
+        tampon.push_back(static_cast<char>(ERREUR));
+        tampon += message;
+    }
+
+    /**
+     * \fn bool extraitTrame(const std::string &tampon, std::size_t &position, std::string &trame)
+     * \brief Extrait une trame complète d'un tampon
+     * \param[in] tampon Le tampon de réception
+     * \param[in,out] position La position de la prochaine trame dans le tampon
+     * \param[out] trame La trame extraite, sans son préfixe de longueur
+     * \return true si une trame complète a été extraite, false sinon
+     * \exception length_error Si la trame annoncée dépasse TAILLE_MAX_TRAME
+     */
+    bool extraitTrame(const std::string &tampon, std::size_t &position, std::string &trame)
+    {
+        if (tampon.size() - position < 4) return false;
+        std::uint32_t longueur = lisU32(tampon.data() + position);
+        if (longueur > TAILLE_MAX_TRAME) throw std::length_error("Trame trop longue");
+        if (tampon.size() - position - 4 < longueur) return false;
+
+        trame.assign(tampon, position + 4, longueur);
+        position += 4 + longueur;
+        return true;
+    }
+
+    /**
+     * \fn std::vector<std::string> decodeListe(const std::string &corps)
+     * \brief Décode le corps d'une réponse liste
+     * \param[in] corps Le corps (trame sans son octet de statut)
+     * \return Les chaînes de la liste
+     * \exception length_error Si le corps est tronqué
+     */
+    std::vector<std::string> decodeListe(const std::string &corps)
+    {
+        if (corps.size() < 2) throw std::length_error("Réponse tronquée");
+        std::vector<std::string> chaines(lisU16(corps.data()));
+        std::size_t position = 2;
+        for (std::size_t i = 0; i < chaines.size(); i++)
+        {
+            if (corps.size() - position < 2) throw std::length_error("Réponse tronquée");
+            std::uint16_t longueur = lisU16(corps.data() + position);
+            position += 2;
+            if (corps.size() - position < longueur) throw std::length_error("Réponse tronquée");
+            chaines[i].assign(corps, position, longueur);
+            position += longueur;
+        }
+        return chaines;
+    }
+
+    /**
+     * \fn static bool estPort(const std::string &adresse)
+     * \brief Indique si une adresse est un numéro de port (TCP) plutôt qu'un chemin de socket Unix
+     * \param[in] adresse L'adresse
+     * \return true si l'adresse ne contient que des chiffres
+     */
+    static bool estPort(const std::string &adresse)
+    {
+        return !adresse.empty() && adresse.find_first_not_of("0123456789") == std::string::npos;
+    }
+
+    /**
+     * \fn static int creeSocket(const std::string &adresse, sockaddr_storage &sa, socklen_t &taille)
+     * \brief Crée une socket et remplit l'adresse correspondante (TCP sur 127.0.0.1 ou Unix)
+     * \param[in] adresse Un numéro de port ou un chemin de socket Unix
+     * \param[out] sa L'adresse de la socket
+     * \param[out] taille La taille de l'adresse
+     * \return Le descripteur de la socket
+     * \exception runtime_error Si la socket ne peut être créée ou si le chemin est trop long
+     */
+    static int creeSocket(const std::string &adresse, sockaddr_storage &sa, socklen_t &taille)
+    {
+        std::memset(&sa, 0, sizeof(sa));
+        int famille;
+        if (estPort(adresse))
+        {
+            sockaddr_in *in = reinterpret_cast<sockaddr_in*>(&sa);
+            in->sin_family = famille = AF_INET;
+            in->sin_port = htons(static_cast<std::uint16_t>(std::stoi(adresse)));
+            in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            taille = sizeof(sockaddr_in);
+        }
+        else
+        {
+            sockaddr_un *un = reinterpret_cast<sockaddr_un*>(&sa);
+            if (adresse.size() >= sizeof(un->sun_path)) throw std::runtime_error("Chemin de socket trop long : " + adresse);
+            un->sun_family = famille = AF_UNIX;
+            std::strcpy(un->sun_path, adresse.c_str());
+            taille = sizeof(sockaddr_un);
+        }
+
+        int fd = socket(famille, SOCK_STREAM, 0);
+        if (fd < 0) throw std::runtime_error(std::string("socket : ") + std::strerror(errno));
+        if (famille == AF_INET)
+        {
+            int un = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &un, sizeof(un));
+        }
+        return fd;
+    }
+
+    /**
+     * \fn int ouvreEcoute(const std::string &adresse)
+     * \brief Ouvre une socket d'écoute non bloquante
+     * \param[in] adresse Un numéro de port (TCP sur 127.0.0.1) ou un chemin de socket Unix
+     * \return Le descripteur de la socket d'écoute
+     * \post Une ancienne socket Unix au même chemin est remplacée
+     * \exception runtime_error Si la socket ne peut être ouverte
+     * \exception runtime_error Si le chemin existe et n'est pas une socket (il n'est pas supprimé)
+     */
+    int ouvreEcoute(const std::string &adresse)
+    {
+        sockaddr_storage sa;
+        socklen_t taille;
+        int fd = creeSocket(adresse, sa, taille);
+
+        int un = 1;
+        if (sa.ss_family == AF_INET) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &un, sizeof(un));
+        else
+        {
+            // On ne retire que ce qui est une socket : un autre fichier (le dictionnaire passé
+            // par erreur à la place du chemin, par exemple) est laissé intact
+            struct stat infos;
+            if (lstat(adresse.c_str(), &infos) == 0)
+            {
+                if (!S_ISSOCK(infos.st_mode))
+                {
+                    close(fd);
+                    throw std::runtime_error("Écoute impossible sur " + adresse + " : le chemin existe et n'est pas une socket");
+                }
+                unlink(adresse.c_str());
+            }
+            else if (errno != ENOENT)
+            {
+                std::string erreur = std::strerror(errno);
+                close(fd);
+                throw std::runtime_error("Écoute impossible sur " + adresse + " : " + erreur);
+            }
+        }
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&sa), taille) < 0 || listen(fd, SOMAXCONN) < 0)
+        {
+            std::string erreur = std::strerror(errno);
+            close(fd);
+            throw std::runtime_error("Écoute impossible sur " + adresse + " : " + erreur);
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        return fd;
+    }
+
+    /**
+     * \fn int connecte(const std::string &adresse)
+     * \brief Se connecte (en mode bloquant) au service de traduction
+     * \param[in] adresse Un numéro de port (TCP sur 127.0.0.1) ou un chemin de socket Unix
+     * \return Le descripteur de la socket connectée
+     * \exception runtime_error Si la connexion échoue
+     */
+    int connecte(const std::string &adresse)
+    {
+        sockaddr_storage sa;
+        socklen_t taille;
+        int fd = creeSocket(adresse, sa, taille);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&sa), taille) < 0)
+        {
+            std::string erreur = std::strerror(errno);
+            close(fd);
+            throw std::runtime_error("Connexion impossible à " + adresse + " : " + erreur);
+        }
+        return fd;
+    }
+
+}
+}
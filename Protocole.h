@@ -0,0 +1,92 @@
+/**
+ * \file Protocole.h
+ * \brief Ce fichier contient le protocole binaire du service de traduction (trames préfixées par leur longueur).
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Tous les entiers sont en ordre réseau (gros-boutiste).
+ *
+ * Requête : u32 longueur | u8 opération ('T', 'A' ou 'S') | octets du mot
+ * Réponse : u32 longueur | u8 statut | corps
+ *    - 'T' et 'S' : corps = u16 nombre de chaînes, puis pour chacune u16 longueur | octets
+ *    - 'A'        : corps = u8 (1 si le mot appartient au dictionnaire, 0 sinon)
+ *    - erreur     : corps = message d'erreur
+ * La longueur compte les octets qui la suivent. Les réponses d'une connexion arrivent
+ * dans l'ordre de ses requêtes.
+ */
+
+
+#ifndef PROTOCOLE_H_
+#define PROTOCOLE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TP3
+{
+namespace Protocole
+{
+
+// Les opérations d'une requête
+enum Operation : unsigned char
+{
+	TRADUIT = 'T',
+	APPARTIENT = 'A',
+	SUGGERE = 'S'
+};
+
+// Le statut d'une réponse
+enum Statut : unsigned char
+{
+	OK = 0,
+	ERREUR = 1
+};
+
+// Taille maximale d'une trame (sans son préfixe de longueur). Une trame plus longue ferme la connexion.
+const std::uint32_t TAILLE_MAX_TRAME = 1 << 16;
+
+//Ajouter à un tampon un entier en ordre réseau
+void ajouteU16(std::string &tampon, std::uint16_t valeur);
+void ajouteU32(std::string &tampon, std::uint32_t valeur);
+
+//Lire un entier en ordre réseau
+std::uint16_t lisU16(const char *octets);
+std::uint32_t lisU32(const char *octets);
+
+//Ajouter à un tampon une requête complète
+void ajouteRequete(std::string &tampon, Operation operation, const std::string &mot);
+
+//Ajouter à un tampon une réponse complète contenant une liste de chaînes (pour 'T' et 'S')
+void ajouteReponseListe(std::string &tampon, const std::vector<std::string> &chaines);
+
+//Ajouter à un tampon une réponse complète contenant un booléen (pour 'A')
+void ajouteReponseBooleen(std::string &tampon, bool valeur);
+
+//Ajouter à un tampon une réponse d'erreur
+void ajouteReponseErreur(std::string &tampon, const std::string &message);
+
+//Extraire une trame complète d'un tampon à partir de la position donnée
+//On retourne false s'il n'y a pas encore de trame complète. Sinon, on retourne true,
+//trame contient la trame (sans préfixe) et position est avancée après elle.
+//Exception	length_error si la trame annoncée dépasse TAILLE_MAX_TRAME
+bool extraitTrame(const std::string &tampon, std::size_t &position, std::string &trame);
+
+//Décoder le corps d'une réponse liste (trame sans son octet de statut)
+//Exception	length_error si le corps est tronqué
+std::vector<std::string> decodeListe(const std::string &corps);
+
+//Ouvrir une socket d'écoute non bloquante. L'adresse est un numéro de port (TCP sur 127.0.0.1)
+//ou un chemin de socket Unix (un fichier existant à ce chemin est remplacé).
+//Exception	runtime_error si la socket ne peut être ouverte
+int ouvreEcoute(const std::string &adresse);
+
+//Se connecter (en mode bloquant) à une adresse de la même forme que pour ouvreEcoute
+//Exception	runtime_error si la connexion échoue
+int connecte(const std::string &adresse);
+
+}
+}
+
+#endif /* PROTOCOLE_H_ */
@@ -0,0 +1,360 @@
+/**
+ * \file ServeurTraduction.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe ServeurTraduction
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "ServeurTraduction.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <numeric> // pour std::iota
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Nombre maximal d'événements traités par réveil de la boucle
+#define NB_EVENEMENTS 256
+
+// Taille du tampon de lecture d'une socket
+#define TAILLE_LECTURE 65536
+
+namespace TP3
+{
+    /**
+     * \fn ServeurTraduction::ServeurTraduction(Dictionnaire &dictionnaire, const std::string &adresse)
+     * \brief Constructeur du serveur. Ouvre la socket d'écoute
+     * \param[in] dictionnaire Le dictionnaire servi. Il doit rester valide tant que le serveur existe
+     * \param[in] adresse Un numéro de port (TCP sur 127.0.0.1) ou un chemin de socket Unix
+     * \exception runtime_error Si la socket ou l'instance epoll ne peuvent être créées
+     */
+    ServeurTraduction::ServeurTraduction(Dictionnaire &dictionnaire, const std::string &adresse)
+        : dictionnaire(dictionnaire), ecoute(-1), epoll(-1), arretDemande(false), prochainId(0), requetesServies(0)
+    {
+        ecoute = Protocole::ouvreEcoute(adresse);
+        epoll = epoll_create1(0);
+        if (epoll < 0)
+        {
+            close(ecoute);
+            throw std::runtime_error(std::string("epoll_create1 : ") + std::strerror(errno));
+        }
+        epoll_event evenement;
+        evenement.events = EPOLLIN;
+        evenement.data.fd = ecoute;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, ecoute, &evenement);
+    }
+
+    /**
+     * \fn ServeurTraduction::~ServeurTraduction()
+     * \brief Destructeur du serveur
+     * \post Toutes les connexions, la socket d'écoute et l'instance epoll sont fermées
+     */
+    ServeurTraduction::~ServeurTraduction()
+    {
+        for (std::unordered_map<int, Connexion>::iterator it = connexions.begin(); it != connexions.end(); ++it)
+        {
+            close(it->first);
+        }
+        close(ecoute);
+        close(epoll);
+    }
+
+    /**
+     * \fn void ServeurTraduction::execute()
+     * \brief Boucle d'événements : accepte les connexions, lit les requêtes, les traite par lot et répond
+     * \post La boucle se termine après un appel à arrete()
+     * \exception runtime_error Si epoll_wait échoue (autrement que par un signal)
+     */
+    void ServeurTraduction::execute()
+    {
+        epoll_event evenements[NB_EVENEMENTS];
+        while (!arretDemande.load())
+        {
+            int n = epoll_wait(epoll, evenements, NB_EVENEMENTS, -1);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("epoll_wait : ") + std::strerror(errno));
+            }
+
+            // On lit tout ce qui est prêt avant de répondre : les requêtes de toutes les connexions
+            // réveillées en même temps forment un seul lot
+            for (int i = 0; i < n; i++)
+            {
+                int fd = evenements[i].data.fd;
+                if (fd == ecoute) _accepte();
+                else if (evenements[i].events & EPOLLERR) _ferme(fd);
+                else
+                {
+                    // Après EPOLLHUP, ce que le client a envoyé avant de fermer est encore lu et servi
+                    if (evenements[i].events & (EPOLLIN | EPOLLHUP)) _lis(fd);
+                    if ((evenements[i].events & (EPOLLOUT | EPOLLHUP)) && connexions.count(fd)) _ecris(fd);
+                }
+            }
+            _traiteLot();
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::arrete()
+     * \brief Demande l'arrêt de la boucle d'événements
+     * \post execute() se termine à son prochain réveil (un signal reçu la réveille)
+     */
+    void ServeurTraduction::arrete()
+    {
+        arretDemande.store(true);
+    }
+
+    /**
+     * \fn std::uint64_t ServeurTraduction::nbRequetes() const
+     * \brief Retourne le nombre de requêtes servies depuis le démarrage
+     * \return Le nombre de réponses ajoutées à une connexion encore ouverte (les requêtes d'une connexion
+     *         fermée avant sa réponse ne sont pas comptées)
+     */
+    std::uint64_t ServeurTraduction::nbRequetes() const
+    {
+        return requetesServies;
+    }
+
+    /**
+     * \fn void ServeurTraduction::_accepte()
+     * \brief Méthode auxiliaire de la boucle pour accepter toutes les connexions en attente
+     * \post Chaque nouvelle connexion est non bloquante et surveillée en lecture
+     */
+    void ServeurTraduction::_accepte()
+    {
+        for (;;)
+        {
+            int fd = accept4(ecoute, nullptr, nullptr, SOCK_NONBLOCK);
+            if (fd < 0) return; // EAGAIN : plus de connexion en attente
+
+            Connexion connexion;
+            connexion.id = prochainId++;
+            connexion.envoye = 0;
+            connexion.enCours = 0;
+            connexion.finLecture = false;
+            connexion.surveillance = EPOLLIN;
+            connexions[fd] = connexion;
+
+            epoll_event evenement;
+            evenement.events = EPOLLIN;
+            evenement.data.fd = fd;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &evenement);
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::_lis(int fd)
+     * \brief Méthode auxiliaire de la boucle pour lire une connexion et ajouter ses requêtes complètes au lot
+     * \param[in] fd La connexion
+     * \post La connexion est fermée tout de suite si la lecture échoue ou si une trame est invalide
+     * \post Si le client a fini d'envoyer, la connexion n'est plus lue. Elle est fermée une fois
+     *       les réponses à ses requêtes envoyées (tout de suite s'il n'y en a aucune)
+     */
+    void ServeurTraduction::_lis(int fd)
+    {
+        Connexion &connexion = connexions[fd];
+        if (connexion.finLecture) return;
+        char tampon[TAILLE_LECTURE];
+        bool fermee = false;
+        for (;;)
+        {
+            ssize_t lus = recv(fd, tampon, sizeof(tampon), 0);
+            if (lus > 0) connexion.entree.append(tampon, lus);
+            else
+            {
+                if (lus == 0) connexion.finLecture = true;
+                else fermee = (errno != EAGAIN && errno != EWOULDBLOCK);
+                break;
+            }
+        }
+
+        std::size_t position = 0;
+        std::string trame;
+        try
+        {
+            while (Protocole::extraitTrame(connexion.entree, position, trame))
+            {
+                if (trame.empty())
+                {
+                    fermee = true;
+                    break;
+                }
+                Requete requete;
+                requete.fd = fd;
+                requete.id = connexion.id;
+                requete.operation = static_cast<Protocole::Operation>(trame[0]);
+                requete.mot.assign(trame, 1, std::string::npos);
+                lot.push_back(std::move(requete));
+                connexion.enCours++;
+            }
+        }
+        catch (std::length_error &)
+        {
+            fermee = true;
+        }
+        connexion.entree.erase(0, position);
+
+        if (fermee) _ferme(fd);
+        else if (connexion.finLecture) _surveille(fd, connexion);
+    }
+
+    /**
+     * \fn void ServeurTraduction::_traiteLot()
+     * \brief Méthode auxiliaire de la boucle pour calculer les réponses du lot et les envoyer
+     * \post Les requêtes sont triées par (opération, mot) : les recherches voisines suivent les mêmes
+     *       chemins dans l'arbre, et une requête répétée dans le lot n'est calculée qu'une fois
+     * \post Les réponses sont ajoutées aux connexions dans l'ordre de leurs requêtes
+     */
+    void ServeurTraduction::_traiteLot()
+    {
+        if (lot.empty()) return;
+
+        std::vector<std::size_t> ordre(lot.size());
+        std::iota(ordre.begin(), ordre.end(), 0);
+        std::sort(ordre.begin(), ordre.end(), [this](std::size_t a, std::size_t b)
+        {
+            if (lot[a].operation != lot[b].operation) return lot[a].operation < lot[b].operation;
+            return lot[a].mot < lot[b].mot;
+        });
+
+        std::vector<std::string> reponses(lot.size());
+        for (std::size_t i = 0; i < ordre.size(); i++)
+        {
+            const Requete &requete = lot[ordre[i]];
+            if (i > 0 && requete.operation == lot[ordre[i - 1]].operation && requete.mot == lot[ordre[i - 1]].mot)
+            {
+                reponses[ordre[i]] = reponses[ordre[i - 1]];
+            }
+            else _repond(requete, reponses[ordre[i]]);
+        }
+
+        std::vector<int> aEcrire;
+        for (std::size_t i = 0; i < lot.size(); i++)
+        {
+            std::unordered_map<int, Connexion>::iterator it = connexions.find(lot[i].fd);
+            if (it == connexions.end() || it->second.id != lot[i].id) continue; // Connexion fermée entre-temps
+            if (it->second.sortie.size() == it->second.envoye) aEcrire.push_back(lot[i].fd);
+            it->second.sortie += reponses[i];
+            it->second.enCours--;
+            requetesServies++;
+        }
+        lot.clear();
+
+        for (std::size_t i = 0; i < aEcrire.size(); i++)
+        {
+            if (connexions.count(aEcrire[i])) _ecris(aEcrire[i]);
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::_repond(const Requete &requete, std::string &reponse)
+     * \brief Méthode auxiliaire à _traiteLot pour calculer la réponse encodée d'une requête
+     * \param[in] requete La requête
+     * \param[out] reponse La trame de réponse
+     */
+    void ServeurTraduction::_repond(const Requete &requete, std::string &reponse)
+    {
+        try
+        {
+            switch (requete.operation)
+            {
+            case Protocole::TRADUIT:
+                Protocole::ajouteReponseListe(reponse, dictionnaire.traduit(requete.mot));
+                break;
+            case Protocole::APPARTIENT:
+                Protocole::ajouteReponseBooleen(reponse, dictionnaire.appartient(requete.mot));
+                break;
+            case Protocole::SUGGERE:
+                Protocole::ajouteReponseListe(reponse, dictionnaire.suggereCorrections(requete.mot));
+                break;
+            default:
+                Protocole::ajouteReponseErreur(reponse, "Opération inconnue");
+            }
+        }
+        catch (std::exception &e)
+        {
+            reponse.clear();
+            Protocole::ajouteReponseErreur(reponse, e.what());
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::_ecris(int fd)
+     * \brief Méthode auxiliaire de la boucle pour envoyer autant que possible de la sortie d'une connexion
+     * \param[in] fd La connexion
+     * \post Si tout n'a pu être envoyé, la connexion est surveillée en écriture jusqu'à ce que ce soit fait
+     * \post Si le client a fini d'envoyer et que toutes ses réponses sont envoyées, la connexion est fermée
+     */
+    void ServeurTraduction::_ecris(int fd)
+    {
+        Connexion &connexion = connexions[fd];
+        while (connexion.envoye < connexion.sortie.size())
+        {
+            ssize_t envoyes = send(fd, connexion.sortie.data() + connexion.envoye, connexion.sortie.size() - connexion.envoye, MSG_NOSIGNAL);
+            if (envoyes < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                _ferme(fd);
+                return;
+            }
+            connexion.envoye += envoyes;
+        }
+
+        if (connexion.envoye == connexion.sortie.size())
+        {
+            connexion.sortie.clear();
+            connexion.envoye = 0;
+        }
+        _surveille(fd, connexion);
+    }
+
+    /**
+     * \fn void ServeurTraduction::_surveille(int fd, Connexion &connexion)
+     * \brief Méthode auxiliaire de la boucle pour ajuster les événements surveillés d'une connexion
+     * \param[in] fd La connexion
+     * \param[in] connexion Son état
+     * \post La connexion est surveillée en lecture tant que le client envoie, et en écriture tant
+     *       qu'il reste de la sortie. Si elle n'a plus rien à lire, à répondre ni à envoyer, elle est fermée
+     */
+    void ServeurTraduction::_surveille(int fd, Connexion &connexion)
+    {
+        bool reste = connexion.envoye < connexion.sortie.size();
+        if (connexion.finLecture && !reste && connexion.enCours == 0)
+        {
+            _ferme(fd);
+            return;
+        }
+
+        std::uint32_t surveillance = 0;
+        if (!connexion.finLecture) surveillance |= EPOLLIN;
+        if (reste) surveillance |= EPOLLOUT;
+        if (surveillance != connexion.surveillance)
+        {
+            epoll_event evenement;
+            evenement.events = surveillance;
+            evenement.data.fd = fd;
+            epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &evenement);
+            connexion.surveillance = surveillance;
+        }
+    }
+
+    /**
+     * \fn void ServeurTraduction::_ferme(int fd)
+     * \brief Méthode auxiliaire de la boucle pour fermer une connexion
+     * \param[in] fd La connexion
+     * \post Les réponses encore attendues par cette connexion sont abandonnées
+     */
+    void ServeurTraduction::_ferme(int fd)
+    {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        connexions.erase(fd);
+    }
+
+}//Fin du namespace
@@ -0,0 +1,94 @@
+/**
+ * \file ServeurTraduction.h
+ * \brief Ce fichier contient l'interface d'un service de traduction qui garde un dictionnaire chargé en mémoire.
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef SERVEUR_TRADUCTION_H_
+#define SERVEUR_TRADUCTION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Dictionnaire.h"
+#include "Protocole.h"
+
+namespace TP3
+{
+
+//classe représentant un service de traduction sur socket Unix ou TCP local (voir Protocole.h).
+//Une seule boucle d'événements (epoll) sert toutes les connexions. Les requêtes reçues lors d'un même
+//réveil forment un lot : elles sont triées par mot et chaque requête distincte n'est calculée qu'une fois.
+class ServeurTraduction
+{
+public:
+
+	//Constructeur. Ouvre la socket d'écoute à l'adresse donnée (numéro de port ou chemin de socket Unix)
+	//Le dictionnaire doit rester valide tant que le serveur existe
+	//Exception	runtime_error si la socket ne peut être ouverte
+	ServeurTraduction(Dictionnaire &dictionnaire, const std::string &adresse);
+
+	//Destructeur. Ferme toutes les connexions
+	~ServeurTraduction();
+
+	//Servir les requêtes jusqu'à ce que arrete() soit appelée
+	//Exception	runtime_error si la boucle d'événements échoue
+	void execute();
+
+	//Demander l'arrêt de la boucle d'événements (peut être appelée d'un gestionnaire de signal)
+	void arrete();
+
+	//Retourner le nombre de requêtes servies depuis le démarrage
+	std::uint64_t nbRequetes() const;
+
+private:
+
+	// Une connexion cliente et ses tampons
+	struct Connexion
+	{
+		std::uint64_t id;		// Identifiant unique (un descripteur peut être réutilisé)
+		std::string entree;		// Octets reçus, pas encore analysés
+		std::string sortie;		// Octets à envoyer
+		std::size_t envoye;		// Nombre d'octets de sortie déjà envoyés
+		std::size_t enCours;		// Nombre de requêtes dans le lot en cours, pas encore répondues
+		bool finLecture;		// Le client a fini d'envoyer (fin de fichier ou EPOLLHUP)
+		std::uint32_t surveillance;	// Les événements epoll surveillés pour cette connexion
+	};
+
+	// Une requête du lot en cours
+	struct Requete
+	{
+		int fd;				// La connexion qui a envoyé la requête
+		std::uint64_t id;		// L'identifiant de cette connexion
+		Protocole::Operation operation;
+		std::string mot;
+	};
+
+	Dictionnaire &dictionnaire;		// Le dictionnaire servi
+	int ecoute;				// La socket d'écoute
+	int epoll;				// L'instance epoll
+	std::atomic<bool> arretDemande;		// arrete() a-t-elle été appelée ?
+	std::uint64_t prochainId;		// Le prochain identifiant de connexion
+	std::uint64_t requetesServies;		// Le nombre de réponses ajoutées à une connexion encore ouverte
+	std::unordered_map<int, Connexion> connexions;	// Les connexions ouvertes, par descripteur
+	std::vector<Requete> lot;		// Les requêtes reçues lors du réveil en cours
+
+	// Méthodes auxiliaires de la boucle d'événements
+	void _accepte();
+	void _lis(int fd);
+	void _traiteLot();
+	void _repond(const Requete &requete, std::string &reponse);
+	void _ecris(int fd);
+	void _surveille(int fd, Connexion &connexion);
+	void _ferme(int fd);
+};
+
+}
+
+#endif /* SERVEUR_TRADUCTION_H_ */
@@ -0,0 +1,187 @@
+/**
+ * \file Tokeniseur.cpp
+ * \brief Ce fichier contient une implantation des méthodes de la classe Tokeniseur
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+#include "Tokeniseur.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace TP3
+{
+    // Lettre de base (sans accent, en minuscule) des caractères U+00C0 à U+00FF.
+    // '\0' : pas une lettre (×, ÷), traité comme un séparateur. 'S' : ß, 'A' : æ (deux lettres, voir plus bas)
+    static const char LATIN1_SANS_ACCENT[64 + 1] =
+        "aaaaaaAceeeeiiii"   // U+00C0 À Á Â Ã Ä Å Æ Ç È É Ê Ë Ì Í Î Ï
+        "dnooooo\0ouuuuytS"  // U+00D0 Ð Ñ Ò Ó Ô Õ Ö × Ø Ù Ú Û Ü Ý Þ ß
+        "aaaaaaAceeeeiiii"   // U+00E0 à á â ã ä å æ ç è é ê ë ì í î ï
+        "dnooooo\0ouuuuyty"; // U+00F0 ð ñ ò ó ô õ ö ÷ ø ù ú û ü ý þ ÿ
+
+    /**
+     * \fn Tokeniseur::Tokeniseur(bool vectoriel)
+     * \brief Constructeur de la classe Tokeniseur
+     * \param[in] vectoriel Si faux, le texte est toujours traité un caractère à la fois (sans SSE2)
+     */
+    Tokeniseur::Tokeniseur(bool vectoriel) : vectoriel(vectoriel) {}
+
+    /**
+     * \fn const std::vector<std::string_view> &Tokeniseur::decoupe(std::string_view texte)
+     * \brief Découpe un texte brut en mots normalisés
+     * \param[in] texte Le texte (UTF-8)
+     * \return Les mots, dans l'ordre du texte. Les vues restent valides jusqu'au prochain appel
+     * \post Une apostrophe au début ou à la fin d'un mot est retirée
+     */
+    const std::vector<std::string_view> &Tokeniseur::decoupe(std::string_view texte)
+    {
+        _normalise(texte);
+        mots.clear();
+
+        std::string_view normalise(tampon);
+        std::size_t debut = normalise.find_first_not_of(' ');
+        while (debut != std::string_view::npos)
+        {
+            std::size_t fin = normalise.find(' ', debut);
+            if (fin == std::string_view::npos) fin = normalise.size();
+
+            std::string_view mot = normalise.substr(debut, fin - debut);
+            while (!mot.empty() && mot.front() == '\'') mot.remove_prefix(1);
+            while (!mot.empty() && mot.back() == '\'') mot.remove_suffix(1);
+            if (!mot.empty()) mots.push_back(mot);
+
+            debut = normalise.find_first_not_of(' ', fin);
+        }
+        return mots;
+    }
+
+    /**
+     * \fn void Tokeniseur::_normalise(std::string_view texte)
+     * \brief Méthode auxiliaire de decoupe pour normaliser un texte dans le tampon
+     * \param[in] texte Le texte (UTF-8)
+     * \post Le tampon ne contient que des lettres normalisées, des apostrophes et des espaces (séparateurs),
+     *       ainsi que les caractères non ASCII inconnus, gardés tels quels
+     */
+    void Tokeniseur::_normalise(std::string_view texte)
+    {
+        tampon.clear();
+        tampon.reserve(texte.size() + 16);
+
+        std::size_t i = 0;
+        while (i < texte.size())
+        {
+#if defined(__SSE2__)
+            // Chemin rapide : 16 octets ASCII à la fois
+            if (vectoriel && i + 16 <= texte.size())
+            {
+                __m128i octets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texte.data() + i));
+                if (_mm_movemask_epi8(octets) == 0) // Aucun octet >= 0x80 : les comparaisons signées sont valides
+                {
+                    // 'A'..'Z' -> 'a'..'z'
+                    __m128i majuscules = _mm_and_si128(_mm_cmpgt_epi8(octets, _mm_set1_epi8('A' - 1)),
+                                                       _mm_cmplt_epi8(octets, _mm_set1_epi8('Z' + 1)));
+                    __m128i minuscules = _mm_or_si128(octets, _mm_and_si128(majuscules, _mm_set1_epi8(0x20)));
+
+                    // On garde les lettres et les apostrophes, le reste devient un espace
+                    __m128i lettres = _mm_and_si128(_mm_cmpgt_epi8(minuscules, _mm_set1_epi8('a' - 1)),
+                                                    _mm_cmplt_epi8(minuscules, _mm_set1_epi8('z' + 1)));
+                    __m128i garde = _mm_or_si128(lettres, _mm_cmpeq_epi8(octets, _mm_set1_epi8('\'')));
+                    __m128i resultat = _mm_or_si128(_mm_and_si128(garde, minuscules),
+                                                    _mm_andnot_si128(garde, _mm_set1_epi8(' ')));
+
+                    std::size_t taille = tampon.size();
+                    tampon.resize(taille + 16);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(&tampon[taille]), resultat);
+                    i += 16;
+                    continue;
+                }
+            }
+#endif
+            // Chemin général : un caractère (ASCII ou séquence UTF-8) à la fois
+            i = _normaliseCaractere(texte, i, tampon);
+        }
+    }
+
+    /**
+     * \fn std::size_t Tokeniseur::_normaliseCaractere(std::string_view texte, std::size_t i, std::string &sortie)
+     * \brief Méthode auxiliaire de _normalise pour normaliser un seul caractère
+     * \param[in] texte Le texte (UTF-8)
+     * \param[in] i La position du premier octet du caractère
+     * \param[out] sortie Le tampon auquel le caractère normalisé est ajouté
+     * \return La position du caractère suivant
+     * \post Une séquence UTF-8 invalide (premier octet hors de C2-F4, forme trop longue, substitut UTF-16,
+     *       valeur au-delà de U+10FFFF) ou tronquée est remplacée par un séparateur, octet par octet
+     */
+    std::size_t Tokeniseur::_normaliseCaractere(std::string_view texte, std::size_t i, std::string &sortie)
+    {
+        unsigned char c = texte[i];
+        if (c < 0x80)
+        {
+            if (c >= 'A' && c <= 'Z') sortie.push_back(c | 0x20);
+            else if ((c >= 'a' && c <= 'z') || c == '\'') sortie.push_back(c);
+            else sortie.push_back(' ');
+            return i + 1;
+        }
+
+        // Longueur de la séquence selon le premier octet, et plage permise du deuxième octet
+        // (E0 et F0 : pas de forme trop longue, ED : pas de substitut, F4 : pas au-delà de U+10FFFF)
+        std::size_t longueur = 0;
+        unsigned char min2 = 0x80, max2 = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) longueur = 2;
+        else if (c >= 0xE0 && c <= 0xEF)
+        {
+            longueur = 3;
+            if (c == 0xE0) min2 = 0xA0;
+            else if (c == 0xED) max2 = 0x9F;
+        }
+        else if (c >= 0xF0 && c <= 0xF4)
+        {
+            longueur = 4;
+            if (c == 0xF0) min2 = 0x90;
+            else if (c == 0xF4) max2 = 0x8F;
+        }
+        if (longueur == 0 || i + longueur > texte.size())
+        {
+            sortie.push_back(' ');
+            return i + 1;
+        }
+        unsigned char c2 = texte[i + 1];
+        if (c2 < min2 || c2 > max2)
+        {
+            sortie.push_back(' ');
+            return i + 1;
+        }
+        for (std::size_t k = 2; k < longueur; k++)
+        {
+            if ((static_cast<unsigned char>(texte[i + k]) & 0xC0) != 0x80)
+            {
+                sortie.push_back(' ');
+                return i + 1;
+            }
+        }
+
+        if (c == 0xC3) // U+00C0 à U+00FF : lettres accentuées latines
+        {
+            char base = LATIN1_SANS_ACCENT[c2 - 0x80];
+            if (base == '\0') sortie.push_back(' ');
+            else if (base == 'S') sortie += "ss";
+            else if (base == 'A') sortie += "ae";
+            else sortie.push_back(base);
+        }
+        else if (c == 0xC5 && (c2 == 0x92 || c2 == 0x93)) sortie += "oe"; // Œ, œ
+        else if (c == 0xC2) sortie.push_back(' '); // U+0080 à U+00BF : espace insécable, ponctuation, symboles
+        else if (c == 0xE2 && c2 == 0x80)
+        {
+            // U+2018 et U+2019 (apostrophes typographiques) -> apostrophe, autres U+20xx (tirets, guillemets, ...) -> séparateur
+            unsigned char c3 = texte[i + 2];
+            sortie.push_back((c3 == 0x98 || c3 == 0x99) ? '\'' : ' ');
+        }
+        else sortie.append(texte.data() + i, longueur); // Autre caractère : gardé tel quel
+        return i + longueur;
+    }
+
+}//Fin du namespace
@@ -0,0 +1,51 @@
+/**
+ * \file Tokeniseur.h
+ * \brief Ce fichier contient l'interface d'un découpeur de texte brut en mots normalisés pour le dictionnaire.
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ */
+
+
+#ifndef TOKENISEUR_H_
+#define TOKENISEUR_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace TP3
+{
+
+//classe représentant un découpeur de texte brut (UTF-8) en mots prêts pour la recherche dans le dictionnaire.
+//Le texte est normalisé comme les mots de EnglishFrench.txt : majuscules ASCII mises en minuscules,
+//accents retirés (é -> e, ç -> c, œ -> oe, ...), chiffres et ponctuation traités comme des séparateurs.
+//L'apostrophe est gardée à l'intérieur d'un mot (c'mon, ma'am). Les autres caractères non ASCII sont
+//gardés tels quels. Le texte ASCII est traité 16 octets à la fois (SSE2) lorsque c'est possible.
+class Tokeniseur
+{
+public:
+
+	//Constructeur. Si vectoriel est faux, le chemin SSE2 n'est jamais pris : le résultat doit être le même,
+	//ce qui permet de comparer les deux chemins
+	explicit Tokeniseur(bool vectoriel = true);
+
+	//Découper un texte en mots normalisés
+	//Les vues retournées pointent dans un tampon interne : elles restent valides jusqu'au prochain appel
+	const std::vector<std::string_view> &decoupe(std::string_view texte);
+
+private:
+
+	bool vectoriel;				// Le chemin SSE2 est-il permis ?
+	std::string tampon;			// Le texte normalisé (les séparateurs deviennent des espaces)
+	std::vector<std::string_view> mots;	// Les mots du dernier texte découpé
+
+	// Méthodes auxiliaires de normalisation
+	void _normalise(std::string_view texte);
+	static std::size_t _normaliseCaractere(std::string_view texte, std::size_t i, std::string &sortie);
+};
+
+}
+
+#endif /* TOKENISEUR_H_ */
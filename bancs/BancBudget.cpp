@@ -0,0 +1,145 @@
+/**
+ * \file BancBudget.cpp
+ * \brief Banc d'essai : latence de suggereCorrections, sans et avec budget (évaluations ou délai)
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancBudget [fichier = EnglishFrench.txt] [nbRequetes = 150]
+ * Les requêtes sont des mots du dictionnaire avec 1 ou 2 fautes au hasard. Pour chaque réglage, affiche
+ * les percentiles de la latence (en microsecondes), un histogramme par puissances de 2, le nombre de
+ * recherches exhaustives et le rappel : la part du vrai top 5 (recherche sans limite) qui est retournée.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Un réglage de la recherche. budget et delai à 0 : pas de limite. original : suggereCorrections(mot)
+struct Reglage
+{
+    const char *nom;
+    bool original;
+    unsigned int budget;
+    long delai;
+};
+
+// Le mot avec nbFautes fautes : insertion, suppression ou substitution d'une lettre au hasard
+static std::string ajouteFautes(std::string mot, unsigned int nbFautes, std::mt19937 &hasard)
+{
+    for (unsigned int f = 0; f < nbFautes; f++)
+    {
+        std::size_t position = mot.empty() ? 0 : hasard() % mot.size();
+        char lettre = char('a' + hasard() % 26);
+        switch (hasard() % 3)
+        {
+        case 0: mot.insert(mot.begin() + position, lettre); break;
+        case 1: if (!mot.empty()) mot.erase(mot.begin() + position); break;
+        default: if (!mot.empty()) mot[position] = lettre; break;
+        }
+    }
+    return mot;
+}
+
+// Le percentile p (entre 0 et 1) de latences triées
+static double percentile(const std::vector<double> &latences, double p)
+{
+    return latences[std::min(latences.size() - 1, std::size_t(p * latences.size()))];
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    unsigned int nbRequetes = (argc > 2) ? std::atoi(argv[2]) : 150;
+
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+    Dictionnaire dictionnaire(fichier);
+
+    std::vector<std::string> mots;
+    std::ifstream relu(nomFichier);
+    std::string ligne, motAnglais, motTraduit;
+    while (std::getline(relu, ligne))
+        if (Dictionnaire::lisLigne(ligne, motAnglais, motTraduit) && motAnglais.size() > 2) mots.push_back(motAnglais);
+
+    std::mt19937 hasard(3);
+    std::vector<std::string> requetes;
+    while (requetes.size() < nbRequetes)
+    {
+        std::string requete = ajouteFautes(mots[hasard() % mots.size()], 1 + hasard() % 2, hasard);
+        if (!dictionnaire.appartient(requete)) requetes.push_back(requete);
+    }
+
+    // Le vrai top 5 de chaque requête
+    std::vector<std::vector<std::string> > references(requetes.size());
+    bool estExhaustif;
+    for (std::size_t r = 0; r < requetes.size(); r++)
+        references[r] = dictionnaire.suggereCorrections(requetes[r], 0, std::chrono::microseconds(0), estExhaustif);
+
+    const Reglage reglages[] = {
+        { "original", true, 0, 0 },
+        { "sans limite", false, 0, 0 },
+        { "budget 20000", false, 20000, 0 },
+        { "budget 5000", false, 5000, 0 },
+        { "budget 1000", false, 1000, 0 },
+        { "delai 5 ms", false, 0, 5000 },
+        { "delai 2 ms", false, 0, 2000 },
+    };
+
+    std::printf("%s, %u requetes (latences en microsecondes)\n", nomFichier, nbRequetes);
+    std::printf("%-14s %8s %8s %8s %8s %11s %7s   histogramme (< 250, < 500, < 1000, ... us)\n",
+                "", "p50", "p90", "p99", "max", "exhaustives", "rappel");
+    for (const Reglage &reglage : reglages)
+    {
+        std::vector<double> latences;
+        unsigned int nbExhaustives = 0, nbTrouvees = 0, nbAttendues = 0;
+        for (std::size_t r = 0; r < requetes.size(); r++)
+        {
+            std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+            std::vector<std::string> suggestions;
+            if (reglage.original)
+            {
+                suggestions = dictionnaire.suggereCorrections(requetes[r]);
+                estExhaustif = true;
+            }
+            else
+            {
+                suggestions = dictionnaire.suggereCorrections(requetes[r], reglage.budget,
+                                                              std::chrono::microseconds(reglage.delai), estExhaustif);
+            }
+            latences.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - debut).count());
+
+            nbExhaustives += estExhaustif;
+            nbAttendues += references[r].size();
+            for (std::size_t s = 0; s < suggestions.size(); s++)
+                nbTrouvees += std::count(references[r].begin(), references[r].end(), suggestions[s]) > 0;
+        }
+        std::sort(latences.begin(), latences.end());
+
+        // Histogramme : la case k compte les latences sous 250 x 2^k microsecondes (la dernière, le reste)
+        std::vector<unsigned int> cases(9, 0);
+        for (std::size_t i = 0; i < latences.size(); i++)
+        {
+            std::size_t k = 0;
+            while (k + 1 < cases.size() && latences[i] >= 250.0 * (1 << k)) k++;
+            cases[k]++;
+        }
+
+        std::printf("%-14s %8.0f %8.0f %8.0f %8.0f %7u/%-3u", reglage.nom, percentile(latences, 0.5),
+                    percentile(latences, 0.9), percentile(latences, 0.99), latences.back(), nbExhaustives, nbRequetes);
+        if (reglage.original) std::printf(" %7s  ", "-");
+        else std::printf(" %7.3f  ", nbAttendues ? double(nbTrouvees) / nbAttendues : 1.0);
+        for (std::size_t k = 0; k < cases.size(); k++) std::printf(" %4u", cases[k]);
+        std::printf("\n");
+    }
+    return 0;
+}
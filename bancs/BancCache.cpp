@@ -0,0 +1,114 @@
+/**
+ * \file BancCache.cpp
+ * \brief Banc d'essai : cache des mots fréquents (CacheMotsFrequents) devant l'arbre, sous une loi de Zipf
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancCache [fichier = EnglishFrench.txt] [nbAcces = 2000000]
+ * Charge le dictionnaire, puis tire nbAcces mots selon une loi de Zipf d'exposant s (0 = uniforme).
+ * Pour chaque s, affiche le taux de succès du cache et le temps moyen de appartient et de traduit
+ * avec et sans le cache (Dictionnaire::activeCache), le meilleur de 3 passes.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Un noeud minimal pour mesurer le taux de succès du cache sans passer par l'arbre
+struct NoeudBanc
+{
+    std::string mot;
+};
+
+// Durée moyenne d'un appel, en nanosecondes, le meilleur de 3 passes sur le flux
+template <typename Operation>
+static double nanosecondesParAppel(const std::vector<const std::string *> &flux, Operation operation)
+{
+    double meilleur = 1e18;
+    for (int passe = 0; passe < 3; passe++)
+    {
+        std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < flux.size(); i++) operation(*flux[i]);
+        double duree = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - debut).count();
+        meilleur = std::min(meilleur, duree / flux.size());
+    }
+    return meilleur;
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    std::size_t nbAcces = (argc > 2) ? std::atoi(argv[2]) : 2000000;
+
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+    Dictionnaire dictionnaire(fichier);
+
+    // Les mots distincts du fichier, dans un ordre aléatoire : le rang d'un mot dans la loi de Zipf
+    std::vector<std::string> mots;
+    std::ifstream relu(nomFichier);
+    std::string ligne, motAnglais, motTraduit;
+    while (std::getline(relu, ligne))
+        if (Dictionnaire::lisLigne(ligne, motAnglais, motTraduit)) mots.push_back(motAnglais);
+    std::sort(mots.begin(), mots.end());
+    mots.erase(std::unique(mots.begin(), mots.end()), mots.end());
+    std::mt19937 hasard(42);
+    std::shuffle(mots.begin(), mots.end(), hasard);
+
+    std::printf("%zu mots, %zu acces par passe\n", mots.size(), nbAcces);
+    std::printf("%5s %10s %14s %14s %14s %14s\n", "s", "succes", "appartient", "sans cache", "traduit", "sans cache");
+
+    unsigned int nbVerifications = 0;
+    for (double s : {0.0, 0.8, 1.0, 1.2})
+    {
+        // Le flux de mots : on tire le rang par la fonction de répartition cumulée
+        std::vector<double> repartition(mots.size());
+        double somme = 0;
+        for (std::size_t i = 0; i < mots.size(); i++)
+        {
+            somme += 1.0 / std::pow(double(i + 1), s);
+            repartition[i] = somme;
+        }
+        std::uniform_real_distribution<double> uniforme(0, somme);
+        std::vector<const std::string *> flux(nbAcces);
+        for (std::size_t i = 0; i < nbAcces; i++)
+            flux[i] = &mots[std::lower_bound(repartition.begin(), repartition.end(), uniforme(hasard)) - repartition.begin()];
+
+        // Taux de succès : un cache neuf rejoue le flux comme le fait Dictionnaire (cherche, puis propose sur un échec)
+        std::vector<NoeudBanc> noeuds(mots.size());
+        for (std::size_t i = 0; i < mots.size(); i++) noeuds[i].mot = mots[i];
+        CacheMotsFrequents<NoeudBanc> cache;
+        std::size_t nbSucces = 0;
+        for (std::size_t i = 0; i < nbAcces; i++)
+        {
+            std::size_t hachage = std::hash<std::string_view>()(*flux[i]);
+            if (cache.cherche(*flux[i], hachage) != nullptr) nbSucces++;
+            else cache.propose(&noeuds[flux[i] - &mots[0]], hachage);
+        }
+
+        std::size_t total = 0;
+        dictionnaire.activeCache(true);
+        double appartientAvec = nanosecondesParAppel(flux, [&](const std::string &mot) { total += dictionnaire.appartient(mot); });
+        double traduitAvec = nanosecondesParAppel(flux, [&](const std::string &mot) { total += dictionnaire.traduit(mot).size(); });
+        dictionnaire.activeCache(false);
+        double appartientSans = nanosecondesParAppel(flux, [&](const std::string &mot) { total += dictionnaire.appartient(mot); });
+        double traduitSans = nanosecondesParAppel(flux, [&](const std::string &mot) { total += dictionnaire.traduit(mot).size(); });
+        nbVerifications += total > 0;
+
+        std::printf("%5.1f %9.1f%% %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n", s, 100.0 * nbSucces / nbAcces,
+                    appartientAvec, appartientSans, traduitAvec, traduitSans);
+    }
+    return nbVerifications == 4 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * \file BancCompact.cpp
+ * \brief Banc d'essai : mémoire et latence d'un DictionnaireCompact, comparé à l'arbre AVL de Dictionnaire
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancCompact [fichier = EnglishFrench.txt] [nbRequetes = 1000000]
+ * Mesure la mémoire des deux dictionnaires chargés du fichier, puis le temps moyen de appartient et de
+ * traduit pour nbRequetes mots du fichier tirés au hasard et pour autant de mots absents (le meilleur de
+ * 3 passes). La mémoire est comptée par l'opérateur new global, remplacé ici : ce sont les octets demandés,
+ * sans le surcoût de malloc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include "../DictionnaireCompact.h"
+
+using namespace TP3;
+
+// Atomique : le chargement du fichier alloue aussi dans d'autres threads
+static std::atomic<std::size_t> octetsVivants(0);
+
+// Chaque bloc garde sa taille devant lui, pour la soustraire à sa libération
+void *operator new(std::size_t taille)
+{
+    void *p = std::malloc(taille + 16);
+    if (p == nullptr) throw std::bad_alloc();
+    *static_cast<std::size_t *>(p) = taille;
+    octetsVivants += taille;
+    return static_cast<char *>(p) + 16;
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p == nullptr) return;
+    char *bloc = static_cast<char *>(p) - 16;
+    octetsVivants -= *reinterpret_cast<std::size_t *>(bloc);
+    std::free(bloc);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+// Durée moyenne d'un appel, en nanosecondes, le meilleur de 3 passes sur les requêtes
+template <typename Operation>
+static double nanosecondesParAppel(const std::vector<std::string> &requetes, Operation operation)
+{
+    double meilleur = 1e18;
+    for (int passe = 0; passe < 3; passe++)
+    {
+        std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < requetes.size(); i++) operation(requetes[i]);
+        double duree = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - debut).count();
+        meilleur = std::min(meilleur, duree / requetes.size());
+    }
+    return meilleur;
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    std::size_t nbRequetes = (argc > 2) ? std::atoi(argv[2]) : 1000000;
+
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+    std::size_t avant = octetsVivants;
+    Dictionnaire dictionnaire(fichier);
+    std::size_t memoireArbre = octetsVivants - avant;
+    avant = octetsVivants;
+    DictionnaireCompact compact(dictionnaire);
+    std::size_t memoireCompact = octetsVivants - avant;
+
+    std::vector<std::string> mots;
+    std::ifstream relu(nomFichier);
+    std::string ligne, motAnglais, motTraduit;
+    while (std::getline(relu, ligne))
+        if (Dictionnaire::lisLigne(ligne, motAnglais, motTraduit)) mots.push_back(motAnglais);
+
+    // Les mots absents partagent un long préfixe avec un mot présent : tout le bloc est parcouru
+    std::mt19937 hasard(1);
+    std::vector<std::string> presents(nbRequetes), absents(nbRequetes);
+    for (std::size_t i = 0; i < nbRequetes; i++)
+    {
+        presents[i] = mots[hasard() % mots.size()];
+        absents[i] = mots[hasard() % mots.size()] + "q";
+    }
+
+    std::printf("%s : %u mots\n", nomFichier, dictionnaire.taille());
+    std::printf("  memoire : arbre AVL %zu Ko, compact %zu Ko (tampons %zu Ko)\n",
+                memoireArbre / 1024, memoireCompact / 1024, compact.memoireUtilisee() / 1024);
+
+    // Le cache des mots fréquents est coupé : on compare les deux structures elles-mêmes
+    dictionnaire.activeCache(false);
+    std::size_t total = 0;
+    std::printf("  %-22s %10s %10s\n", "", "arbre", "compact");
+    std::printf("  %-22s %7.0f ns %7.0f ns\n", "appartient (present)",
+                nanosecondesParAppel(presents, [&](const std::string &mot) { total += dictionnaire.appartient(mot); }),
+                nanosecondesParAppel(presents, [&](const std::string &mot) { total += compact.appartient(mot); }));
+    std::printf("  %-22s %7.0f ns %7.0f ns\n", "appartient (absent)",
+                nanosecondesParAppel(absents, [&](const std::string &mot) { total += dictionnaire.appartient(mot); }),
+                nanosecondesParAppel(absents, [&](const std::string &mot) { total += compact.appartient(mot); }));
+    std::printf("  %-22s %7.0f ns %7.0f ns\n", "traduit (present)",
+                nanosecondesParAppel(presents, [&](const std::string &mot) { total += dictionnaire.traduit(mot).size(); }),
+                nanosecondesParAppel(presents, [&](const std::string &mot) { total += compact.traduit(mot).size(); }));
+    std::printf("  (%zu resultats)\n", total);
+    return 0;
+}
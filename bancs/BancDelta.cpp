@@ -0,0 +1,96 @@
+/**
+ * \file BancDelta.cpp
+ * \brief Banc d'essai : appliquer un delta (Dictionnaire::appliqueDelta) contre recharger tout le fichier
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancDelta [nbMots = 200000] [pourcentage = 1]
+ * Génère un dictionnaire synthétique de nbMots mots et un delta qui touche pourcentage % des mots
+ * (moitié ajouts, moitié suppressions), puis compare le temps de rechargement complet du fichier
+ * modifié au temps d'application du delta au dictionnaire déjà chargé.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Un mot synthétique de 8 lettres, différent pour chaque indice
+static std::string motSynthetique(unsigned int i)
+{
+    std::string mot;
+    unsigned int x = i * 2654435761u;
+    for (unsigned int k = 0; k < 8; k++)
+    {
+        mot += char('a' + x % 26);
+        x = x / 26 ^ (i * k);
+    }
+    return mot + std::to_string(i % 1000);
+}
+
+// Durée écoulée depuis debut, en millisecondes
+static double millisecondes(std::chrono::steady_clock::time_point debut)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count();
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int nbMots = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    unsigned int pourcentage = (argc > 2) ? std::atoi(argv[2]) : 1;
+    unsigned int nbOperations = nbMots / 100 * pourcentage;
+
+    // Le delta : les ajouts sont de nouveaux mots, les suppressions visent des mots existants
+    std::mt19937 hasard(1);
+    std::vector<bool> supprime(nbMots, false);
+    {
+        std::ofstream delta("banc_delta.txt");
+        for (unsigned int i = 0; i < nbOperations; i++)
+        {
+            if (i % 2) delta << "+\t" << motSynthetique(nbMots + i) << "\tnouveau[Noun]\n";
+            else
+            {
+                unsigned int cible = hasard() % nbMots;
+                supprime[cible] = true;
+                delta << "-\t" << motSynthetique(cible) << "\n";
+            }
+        }
+    }
+    {
+        std::ofstream avant("banc_dico.txt"), apres("banc_dico_apres.txt");
+        for (unsigned int i = 0; i < nbMots; i++)
+        {
+            avant << motSynthetique(i) << "\ttraduction" << i << "[Noun]\n";
+            if (!supprime[i]) apres << motSynthetique(i) << "\ttraduction" << i << "[Noun]\n";
+        }
+        for (unsigned int i = 1; i < nbOperations; i += 2) apres << motSynthetique(nbMots + i) << "\tnouveau[Noun]\n";
+    }
+
+    std::ifstream fichierAvant("banc_dico.txt");
+    Dictionnaire dictionnaire(fichierAvant);
+
+    std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    std::ifstream fichierApres("banc_dico_apres.txt");
+    Dictionnaire recharge(fichierApres);
+    double tempsRechargement = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    std::ifstream fichierDelta("banc_delta.txt");
+    dictionnaire.appliqueDelta(fichierDelta);
+    double tempsDelta = millisecondes(debut);
+
+    bool identiques = dictionnaire.taille() == recharge.taille() && dictionnaire.estEquilibre();
+    std::cout << nbMots << " mots, delta de " << nbOperations << " operations (" << pourcentage << " %)" << std::endl
+              << "  rechargement complet : " << tempsRechargement << " ms" << std::endl
+              << "  appliqueDelta        : " << tempsDelta << " ms" << std::endl
+              << "  tailles identiques et arbre equilibre : " << (identiques ? "oui" : "NON") << std::endl;
+
+    std::remove("banc_dico.txt");
+    std::remove("banc_dico_apres.txt");
+    std::remove("banc_delta.txt");
+    return identiques ? 0 : 1;
+}
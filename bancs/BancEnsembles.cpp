@@ -0,0 +1,106 @@
+/**
+ * \file BancEnsembles.cpp
+ * \brief Banc d'essai : opérations ensemblistes (fusionne, soustrait, supprimeMots) contre des boucles d'insertions et de suppressions
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancEnsembles [n = 200000] [m = 20000]
+ * Le dictionnaire A a n mots, B en a m (en partie communs avec A). On compare A.fusionne(B) à m appels
+ * à ajouteMot, puis A.soustrait(B) et A.supprimeMots(mots de B) à m appels à supprimeMot.
+ * Les résultats sont vérifiés (tailles, équilibre).
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Un mot synthétique, différent pour chaque indice
+static std::string motSynthetique(unsigned int i)
+{
+    std::string mot;
+    unsigned int x = i * 2654435761u;
+    for (unsigned int k = 0; k < 7; k++)
+    {
+        mot += char('a' + x % 26);
+        x /= 26;
+    }
+    return mot + std::to_string(i % 97);
+}
+
+// Durée écoulée depuis debut, en millisecondes
+static double millisecondes(std::chrono::steady_clock::time_point debut)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count();
+}
+
+// Un dictionnaire des mots d'indices donnés, tous traduits par traduction
+static Dictionnaire* construit(const std::vector<unsigned int> &indices, const std::string &traduction)
+{
+    Dictionnaire *dictionnaire = new Dictionnaire();
+    for (std::size_t i = 0; i < indices.size(); i++) dictionnaire->ajouteMot(motSynthetique(indices[i]), traduction);
+    return dictionnaire;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int n = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    unsigned int m = (argc > 2) ? std::atoi(argv[2]) : 20000;
+
+    // A : les indices pairs. B : des multiples de 3 étalés sur la même plage (un tiers en commun avec A)
+    std::vector<unsigned int> indicesA, indicesB;
+    for (unsigned int i = 0; i < n; i++) indicesA.push_back(2 * i);
+    unsigned int pas = (m < n) ? 2 * n / m : 1;
+    for (unsigned int i = 0; i < m; i++) indicesB.push_back(3 * ((i * pas) / 3 + i % 3));
+    std::vector<std::string> motsB;
+    for (std::size_t i = 0; i < indicesB.size(); i++) motsB.push_back(motSynthetique(indicesB[i]));
+
+    Dictionnaire *b = construit(indicesB, "B");
+    Dictionnaire *union1 = construit(indicesA, "A"), *union2 = construit(indicesA, "A");
+    Dictionnaire *difference1 = construit(indicesA, "A"), *difference2 = construit(indicesA, "A"), *difference3 = construit(indicesA, "A");
+
+    std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    union1->fusionne(*b);
+    double tempsFusionne = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < motsB.size(); i++) union2->ajouteMot(motsB[i], "B");
+    double tempsAjouts = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    difference1->soustrait(*b);
+    double tempsSoustrait = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    difference2->supprimeMots(motsB);
+    double tempsSupprimeMots = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < motsB.size(); i++)
+    {
+        if (difference3->appartient(motsB[i])) difference3->supprimeMot(motsB[i]);
+    }
+    double tempsSuppressions = millisecondes(debut);
+
+    bool valide = union1->taille() == union2->taille() && difference1->taille() == difference3->taille()
+               && difference2->taille() == difference3->taille() && union1->estEquilibre()
+               && difference1->estEquilibre() && difference2->estEquilibre();
+
+    std::cout << "A : " << n << " mots, B : " << m << " mots (" << std::thread::hardware_concurrency() << " coeurs)" << std::endl
+              << "  fusionne          : " << tempsFusionne << " ms   (boucle de ajouteMot : " << tempsAjouts << " ms)" << std::endl
+              << "  soustrait         : " << tempsSoustrait << " ms   (boucle de supprimeMot : " << tempsSuppressions << " ms)" << std::endl
+              << "  supprimeMots      : " << tempsSupprimeMots << " ms" << std::endl
+              << "  resultats valides : " << (valide ? "oui" : "NON") << std::endl;
+
+    delete b;
+    delete union1;
+    delete union2;
+    delete difference1;
+    delete difference2;
+    delete difference3;
+    return valide ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+/**
+ * \file BancIndexInverse.cpp
+ * \brief Banc d'essai : mémoire et coût de reconstruction de l'index inverse (français -> anglais)
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancIndexInverse [fichier = EnglishFrench.txt] [nbModifications = 200]
+ * Mesure la mémoire ajoutée par activeIndexInverse, le temps d'une requête inverse avec l'index à jour,
+ * puis nbModifications ajouts faits de deux façons : chacun suivi d'une requête inverse (une reconstruction
+ * complète à chaque fois), ou tous avant une seule requête. La mémoire est comptée par l'opérateur new
+ * global, remplacé ici : ce sont les octets demandés, sans le surcoût de malloc.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Atomique : le chargement du fichier alloue aussi dans d'autres threads
+static std::atomic<std::size_t> octetsVivants(0);
+
+// Chaque bloc garde sa taille devant lui, pour la soustraire à sa libération
+void *operator new(std::size_t taille)
+{
+    void *p = std::malloc(taille + 16);
+    if (p == nullptr) throw std::bad_alloc();
+    *static_cast<std::size_t *>(p) = taille;
+    octetsVivants += taille;
+    return static_cast<char *>(p) + 16;
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p == nullptr) return;
+    char *bloc = static_cast<char *>(p) - 16;
+    octetsVivants -= *reinterpret_cast<std::size_t *>(bloc);
+    std::free(bloc);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+// Durée écoulée depuis debut, en millisecondes
+static double millisecondes(std::chrono::steady_clock::time_point debut)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count();
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    unsigned int nbModifications = (argc > 2) ? std::atoi(argv[2]) : 200;
+
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+    std::size_t avant = octetsVivants;
+    Dictionnaire dictionnaire(fichier);
+    std::size_t memoireArbre = octetsVivants - avant;
+
+    avant = octetsVivants;
+    std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    dictionnaire.activeIndexInverse();
+    double tempsConstruction = millisecondes(debut);
+    std::size_t memoireIndex = octetsVivants - avant;
+
+    std::printf("%s : %u mots\n", nomFichier, dictionnaire.taille());
+    std::printf("  memoire : arbre %zu Ko, index inverse %zu Ko (+%.0f %%, %.0f octets par mot)\n", memoireArbre / 1024,
+                memoireIndex / 1024, 100.0 * memoireIndex / memoireArbre, double(memoireIndex) / dictionnaire.taille());
+    std::printf("  construction de l'index : %.2f ms\n", tempsConstruction);
+
+    const char *requetes[] = { "chat", "chien", "maison", "pomme", "le chat" };
+    std::size_t total = 0;
+    debut = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100000; i++) total += dictionnaire.traduitInverse(requetes[i % 5]).size();
+    std::printf("  traduitInverse, index a jour : %.0f ns\n", millisecondes(debut) * 1e6 / 100000);
+
+    // Chaque modification invalide tout l'index : la requête suivante le reconstruit en entier
+    debut = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nbModifications; i++)
+    {
+        dictionnaire.ajouteMot("alterne" + std::to_string(i), "traduction" + std::to_string(i));
+        total += dictionnaire.traduitInverse("chat").size();
+    }
+    double tempsAlterne = millisecondes(debut);
+
+    debut = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < nbModifications; i++)
+        dictionnaire.ajouteMot("groupe" + std::to_string(i), "traduction" + std::to_string(i));
+    total += dictionnaire.traduitInverse("chat").size();
+    double tempsGroupe = millisecondes(debut);
+
+    std::printf("  %u ajouts, chacun suivi d'une requete inverse : %.2f ms (%.3f ms par ajout)\n",
+                nbModifications, tempsAlterne, tempsAlterne / nbModifications);
+    std::printf("  %u ajouts, puis une seule requete inverse      : %.2f ms\n", nbModifications, tempsGroupe);
+    std::printf("  (%zu resultats)\n", total);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * \file BancMetriques.cpp
+ * \brief Banc d'essai : les politiques de Metriques.h contre le calcul d'origine et un noyau Levenshtein écrit à la main
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancMetriques [fichier = EnglishFrench.txt]
+ * Calcule la similitude d'une paire de mots du fichier par mot (le meilleur de 5 passes), avec le calcul
+ * d'origine (matrice complète en vector<vector>), un noyau à coûts unitaires sur deux rangées et chaque
+ * politique, puis le temps de suggereCorrections pour chaque métrique.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+// Le calcul d'origine de Dictionnaire::similitude : la matrice complète, allouée à chaque appel
+static double similitudeOrigine(std::string_view mot1, std::string_view mot2)
+{
+    std::size_t len1 = mot1.size(), len2 = mot2.size();
+    std::vector<std::vector<unsigned int> > d(len1 + 1, std::vector<unsigned int>(len2 + 1));
+    for (unsigned int i = 1; i <= len1; i++) d[i][0] = i;
+    for (unsigned int j = 1; j <= len2; j++) d[0][j] = j;
+    for (unsigned int i = 1; i <= len1; i++)
+        for (unsigned int j = 1; j <= len2; j++)
+            d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + (mot1[i - 1] == mot2[j - 1] ? 0 : 1) });
+    double maxlen = std::max(len1, len2);
+    return maxlen == 0 ? 1.0 : 1.0 - d[len1][len2] / maxlen;
+}
+
+// Un noyau Levenshtein écrit à la main : coûts unitaires, deux rangées sur la pile (mots d'au plus 64 lettres)
+static double similitudeNoyau(std::string_view mot1, std::string_view mot2)
+{
+    unsigned int derniere[65], courante[65];
+    std::size_t len2 = mot2.size();
+    for (std::size_t j = 0; j <= len2; j++) derniere[j] = j;
+    for (std::size_t i = 1; i <= mot1.size(); i++)
+    {
+        courante[0] = i;
+        for (std::size_t j = 1; j <= len2; j++)
+            courante[j] = std::min({ derniere[j] + 1, courante[j - 1] + 1, derniere[j - 1] + (mot1[i - 1] != mot2[j - 1]) });
+        std::copy(courante, courante + len2 + 1, derniere);
+    }
+    double maxlen = std::max(mot1.size(), len2);
+    return maxlen == 0 ? 1.0 : 1.0 - derniere[len2] / maxlen;
+}
+
+// Durée de la similitude de toutes les paires (mot i, mot i x 7919), en millisecondes, le meilleur de 5 passes
+template <typename Similitude>
+static void mesure(const char *nom, const std::vector<std::string> &mots, Similitude similitude)
+{
+    double meilleur = 1e18, somme = 0;
+    for (int passe = 0; passe < 5; passe++)
+    {
+        std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+        somme = 0;
+        for (std::size_t i = 0; i < mots.size(); i++) somme += similitude(mots[i], mots[(i * 7919) % mots.size()]);
+        meilleur = std::min(meilleur, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count());
+    }
+    std::printf("%-22s %9.2f ms %9.1f ns/paire   (somme %.3f)\n", nom, meilleur, meilleur * 1e6 / mots.size(), somme);
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+
+    std::vector<std::string> mots;
+    std::string ligne, motAnglais, motTraduit;
+    while (std::getline(fichier, ligne))
+        if (Dictionnaire::lisLigne(ligne, motAnglais, motTraduit) && motAnglais.size() <= 64) mots.push_back(motAnglais);
+    std::printf("%zu paires\n", mots.size());
+
+    mesure("origine vector<vector>", mots, similitudeOrigine);
+    mesure("noyau a la main", mots, similitudeNoyau);
+    mesure("Levenshtein", mots, Metriques::similitude<Metriques::Levenshtein>);
+    mesure("DamerauLevenshtein", mots, Metriques::similitude<Metriques::DamerauLevenshtein>);
+    mesure("ClavierQwerty", mots, Metriques::similitude<Metriques::ClavierQwerty>);
+
+    // suggereCorrections parcourt tout l'arbre : la métrique y est choisie une fois par appel
+    std::ifstream relu(nomFichier);
+    Dictionnaire dictionnaire(relu);
+    const char *requetes[] = { "catt", "hapy", "aple", "hous", "teh", "recieve", "hte", "wrold", "gosod", "chaat" };
+    const Metrique metriques[] = { LEVENSHTEIN, DAMERAU_LEVENSHTEIN, CLAVIER_QWERTY };
+    const char *noms[] = { "LEVENSHTEIN", "DAMERAU_LEVENSHTEIN", "CLAVIER_QWERTY" };
+    for (int m = 0; m < 3; m++)
+    {
+        dictionnaire.choisitMetrique(metriques[m]);
+        double meilleur = 1e18;
+        std::size_t nbSuggestions = 0;
+        for (int passe = 0; passe < 5; passe++)
+        {
+            std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+            nbSuggestions = 0;
+            for (const char *requete : requetes) nbSuggestions += dictionnaire.suggereCorrections(requete).size();
+            meilleur = std::min(meilleur, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - debut).count());
+        }
+        std::printf("suggereCorrections %-20s %8.2f ms pour 10 mots (%zu suggestions)\n", noms[m], meilleur, nbSuggestions);
+    }
+    return 0;
+}
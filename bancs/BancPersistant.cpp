@@ -0,0 +1,136 @@
+/**
+ * \file BancPersistant.cpp
+ * \brief Banc d'essai : mémoire et débit d'un DictionnairePersistant, comparé à Dictionnaire
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancPersistant [fichier = EnglishFrench.txt] [nbModifications = 20000]
+ * Mesure la mémoire des deux dictionnaires chargés du fichier, le temps de nbModifications ajouts puis
+ * suppressions, la mémoire de 1000 versions gardées (un ajout chacune), le temps d'une restauration et
+ * celui de appartient. La mémoire est comptée par l'opérateur new global, remplacé ici : ce sont les octets
+ * demandés, sans le surcoût de malloc.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include "../DictionnairePersistant.h"
+
+using namespace TP3;
+
+// Atomique : le chargement du fichier alloue aussi dans d'autres threads
+static std::atomic<std::size_t> octetsVivants(0);
+
+// Chaque bloc garde sa taille devant lui, pour la soustraire à sa libération
+void *operator new(std::size_t taille)
+{
+    void *p = std::malloc(taille + 16);
+    if (p == nullptr) throw std::bad_alloc();
+    *static_cast<std::size_t *>(p) = taille;
+    octetsVivants += taille;
+    return static_cast<char *>(p) + 16;
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p == nullptr) return;
+    char *bloc = static_cast<char *>(p) - 16;
+    octetsVivants -= *reinterpret_cast<std::size_t *>(bloc);
+    std::free(bloc);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+// Durée écoulée depuis debut, en nanosecondes par opération
+static double nanosecondes(std::chrono::steady_clock::time_point debut, std::size_t nbOperations)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - debut).count() / nbOperations;
+}
+
+int main(int argc, char **argv)
+{
+    const char *nomFichier = (argc > 1) ? argv[1] : "EnglishFrench.txt";
+    std::size_t nbModifications = (argc > 2) ? std::atoi(argv[2]) : 20000;
+
+    std::ifstream fichier(nomFichier);
+    if (!fichier)
+    {
+        std::fprintf(stderr, "Impossible d'ouvrir %s\n", nomFichier);
+        return 1;
+    }
+    std::size_t avant = octetsVivants;
+    Dictionnaire dictionnaire(fichier);
+    std::size_t memoireDictionnaire = octetsVivants - avant;
+    avant = octetsVivants;
+    DictionnairePersistant persistant(dictionnaire);
+    std::size_t memoirePersistant = octetsVivants - avant;
+    std::printf("%s : %u mots\n", nomFichier, dictionnaire.taille());
+    std::printf("  memoire : Dictionnaire %zu Ko, DictionnairePersistant %zu Ko\n", memoireDictionnaire / 1024, memoirePersistant / 1024);
+
+    std::mt19937 hasard(2);
+    std::vector<std::string> mots;
+    for (std::size_t i = 0; i < nbModifications; i++) mots.push_back("nouveau" + std::to_string(hasard()));
+
+    std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < mots.size(); i++) dictionnaire.ajouteMot(mots[i], "x");
+    double ajoutDictionnaire = nanosecondes(debut, mots.size());
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < mots.size(); i++) dictionnaire.supprimeMot(mots[i]);
+    double suppressionDictionnaire = nanosecondes(debut, mots.size());
+
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < mots.size(); i++) persistant.ajouteMot(mots[i], "x");
+    double ajoutPersistant = nanosecondes(debut, mots.size());
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < mots.size(); i++) persistant.supprimeMot(mots[i]);
+    double suppressionPersistant = nanosecondes(debut, mots.size());
+
+    std::printf("  %zu ajouts       : Dictionnaire %6.0f ns/op, DictionnairePersistant %6.0f ns/op\n",
+                mots.size(), ajoutDictionnaire, ajoutPersistant);
+    std::printf("  %zu suppressions : Dictionnaire %6.0f ns/op, DictionnairePersistant %6.0f ns/op\n",
+                mots.size(), suppressionDictionnaire, suppressionPersistant);
+
+    // Le coût d'une version gardée : les noeuds copiés sur le chemin de son ajout
+    std::size_t nbVersions = std::min<std::size_t>(1000, mots.size());
+    std::vector<DictionnairePersistant::Version> versions;
+    versions.reserve(nbVersions);
+    avant = octetsVivants;
+    for (std::size_t i = 0; i < nbVersions; i++)
+    {
+        persistant.ajouteMot(mots[i], "y");
+        versions.push_back(persistant.versionCourante());
+    }
+    std::size_t memoireVersions = octetsVivants - avant;
+    std::printf("  %zu versions gardees (un ajout chacune) : %zu Ko, %zu octets par version\n",
+                nbVersions, memoireVersions / 1024, memoireVersions / nbVersions);
+
+    debut = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < 100000; i++) persistant.restaure(versions[i % nbVersions]);
+    std::printf("  restaure : %.0f ns\n", nanosecondes(debut, 100000));
+
+    std::size_t nbTrouves = 0;
+    debut = std::chrono::steady_clock::now();
+    for (int passe = 0; passe < 5; passe++)
+        for (std::size_t i = 0; i < mots.size(); i++) nbTrouves += dictionnaire.appartient(mots[i]);
+    double lectureDictionnaire = nanosecondes(debut, 5 * mots.size());
+    debut = std::chrono::steady_clock::now();
+    for (int passe = 0; passe < 5; passe++)
+        for (std::size_t i = 0; i < mots.size(); i++) nbTrouves += persistant.appartient(mots[i]);
+    double lecturePersistant = nanosecondes(debut, 5 * mots.size());
+    DictionnairePersistant::Version version = persistant.versionCourante();
+    debut = std::chrono::steady_clock::now();
+    for (int passe = 0; passe < 5; passe++)
+        for (std::size_t i = 0; i < mots.size(); i++) nbTrouves += version.appartient(mots[i]);
+    double lectureVersion = nanosecondes(debut, 5 * mots.size());
+    std::printf("  appartient : Dictionnaire %.0f ns, DictionnairePersistant %.0f ns, Version %.0f ns (%zu trouves)\n",
+                lectureDictionnaire, lecturePersistant, lectureVersion, nbTrouves);
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * \file BancReparti.cpp
+ * \brief Banc d'essai : débit d'un DictionnaireReparti sous une charge mixte de lectures et d'écritures
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : BancReparti [nbThreads = 4] [pourcentageEcritures = 10] [nbFragments = 8] [nbOperations = 200000] [nbMots = 100000]
+ * Chaque thread fait nbOperations opérations tirées au hasard sur nbMots mots synthétiques :
+ * pourcentageEcritures % d'écritures (moitié ajouts, moitié suppressions) et le reste en lectures (traduit).
+ * Trois configurations sont mesurées :
+ *   - un seul fragment (un seul verrou pour tout le dictionnaire, la référence) ;
+ *   - nbFragments fragments, chaque thread écrivant lui-même sous le verrou du fragment ;
+ *   - nbFragments fragments, les écritures étant planifiées vers l'écrivain épinglé de chaque fragment
+ *     (le temps d'attendre que les files soient vidées est compté).
+ * Le débit n'a de sens que sur une machine qui a au moins nbThreads coeurs.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include "../DictionnaireReparti.h"
+
+using namespace TP3;
+
+// Un mot synthétique de 8 lettres, différent pour chaque indice
+static std::string motSynthetique(unsigned int i)
+{
+    std::string mot;
+    unsigned int x = i * 2654435761u;
+    for (unsigned int k = 0; k < 8; k++)
+    {
+        mot += char('a' + x % 26);
+        x = x / 26 ^ (i * k);
+    }
+    return mot + std::to_string(i % 1000);
+}
+
+// Faire la charge mixte avec nbThreads threads et retourner le débit en opérations par seconde
+static double mesure(DictionnaireReparti &dictionnaire, const std::vector<std::string> &mots, unsigned int nbThreads,
+                     unsigned int pourcentageEcritures, unsigned int nbOperations, bool viaEcrivains)
+{
+    std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < nbThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::mt19937 hasard(t + 1);
+            for (unsigned int i = 0; i < nbOperations; i++)
+            {
+                const std::string &mot = mots[hasard() % mots.size()];
+                if (hasard() % 100 >= pourcentageEcritures) dictionnaire.traduit(mot);
+                else if (i % 2 == 0)
+                {
+                    if (viaEcrivains) dictionnaire.planifieAjout(mot, "traduction");
+                    else dictionnaire.ajouteMot(mot, "traduction");
+                }
+                else if (viaEcrivains) dictionnaire.planifieSuppression(mot);
+                else
+                {
+                    try { dictionnaire.supprimeMot(mot); }
+                    catch (const std::logic_error &) {} // Déjà supprimé (par ce thread ou un autre)
+                }
+            }
+        });
+    }
+    for (std::size_t t = 0; t < threads.size(); t++) threads[t].join();
+    if (viaEcrivains) dictionnaire.attendEcritures();
+    double secondes = std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+    return nbThreads * double(nbOperations) / secondes;
+}
+
+// Un dictionnaire réparti qui contient tous les mots
+static void remplis(DictionnaireReparti &dictionnaire, const std::vector<std::string> &mots)
+{
+    std::vector<std::pair<std::string, std::string> > paires;
+    for (std::size_t i = 0; i < mots.size(); i++) paires.emplace_back(mots[i], "traduction");
+    dictionnaire.ajouteMots(std::move(paires));
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int nbThreads = (argc > 1) ? std::atoi(argv[1]) : 4;
+    unsigned int pourcentageEcritures = (argc > 2) ? std::atoi(argv[2]) : 10;
+    unsigned int nbFragments = (argc > 3) ? std::atoi(argv[3]) : 8;
+    unsigned int nbOperations = (argc > 4) ? std::atoi(argv[4]) : 200000;
+    unsigned int nbMots = (argc > 5) ? std::atoi(argv[5]) : 100000;
+    if (nbThreads == 0 || nbFragments == 0 || nbMots == 0 || pourcentageEcritures > 100)
+    {
+        std::cerr << "Parametres invalides" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> mots;
+    for (unsigned int i = 0; i < nbMots; i++) mots.push_back(motSynthetique(i));
+
+    DictionnaireReparti unSeul(1), direct(nbFragments), epingle(nbFragments);
+    remplis(unSeul, mots);
+    remplis(direct, mots);
+    remplis(epingle, mots);
+    epingle.demarreEcrivains();
+
+    std::cout << nbThreads << " threads, " << pourcentageEcritures << " % d'ecritures, " << nbOperations
+              << " operations par thread, " << nbMots << " mots ("
+              << std::thread::hardware_concurrency() << " coeurs)" << std::endl
+              << "  1 fragment                       : " << mesure(unSeul, mots, nbThreads, pourcentageEcritures, nbOperations, false) << " op/s" << std::endl
+              << "  " << nbFragments << " fragments, ecritures directes : " << mesure(direct, mots, nbThreads, pourcentageEcritures, nbOperations, false) << " op/s" << std::endl
+              << "  " << nbFragments << " fragments, ecrivains epingles : " << mesure(epingle, mots, nbThreads, pourcentageEcritures, nbOperations, true) << " op/s" << std::endl;
+
+    epingle.arreteEcrivains();
+    bool equilibres = unSeul.estEquilibre() && direct.estEquilibre() && epingle.estEquilibre();
+    std::cout << "  arbres equilibres : " << (equilibres ? "oui" : "NON") << std::endl;
+    return equilibres ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file VerifAllocations.cpp
+ * \brief Vérification : nombre d'allocations des recherches (clés string_view et char*) et de ajouteMot(string&&, string&&)
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifAllocations (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * L'opérateur new global est remplacé pour compter les allocations faites pendant chaque opération.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <string_view>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+static std::size_t nbAllocations = 0;
+
+void *operator new(std::size_t taille)
+{
+    nbAllocations++;
+    void *p = std::malloc(taille ? taille : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+static int nbEchecs = 0;
+
+// Compare le nombre d'allocations faites par une opération au nombre attendu
+template <typename Operation>
+static void verifie(const char *nom, std::size_t attendues, Operation operation)
+{
+    std::size_t avant = nbAllocations;
+    operation();
+    std::size_t faites = nbAllocations - avant;
+    std::printf("%-60s %zu (attendu %zu)%s\n", nom, faites, attendues, faites == attendues ? "" : "  ECHEC");
+    if (faites != attendues) nbEchecs++;
+}
+
+int main()
+{
+    // Des mots et des traductions plus longs que le tampon interne d'une std::string (SSO) :
+    // une chaîne temporaire faite à partir de la clé se verrait
+    Dictionnaire dictionnaire;
+    dictionnaire.ajouteMot("supercalifragilistic", "supercalifragilistique");
+    dictionnaire.ajouteMot("supercalifragilistic", "extraordinairement bon");
+    dictionnaire.ajouteMot("cat", "chat");
+    dictionnaire.ajouteMot("internationalisation", "internationalisation");
+
+    const std::string texte = "the supercalifragilistic caterpillar, internationalization";
+    const std::string_view present = std::string_view(texte).substr(4, 20);
+    const std::string_view absent = std::string_view(texte).substr(38, 20);
+    const std::size_t capaciteSso = std::string().capacity();
+
+    // traduit retourne ses traductions : un vecteur, plus chaque traduction trop longue pour le SSO
+    std::size_t allocationsResultat = 1;
+    std::vector<std::string> traductions = dictionnaire.traduit("supercalifragilistic");
+    for (std::size_t i = 0; i < traductions.size(); i++) if (traductions[i].size() > capaciteSso) allocationsResultat++;
+
+    verifie("appartient(string_view, present) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.appartient(present); });
+    verifie("appartient(string_view, absent) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.appartient(absent); });
+    verifie("appartient(char*, present) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.appartient("supercalifragilistic"); });
+    verifie("appartient(char*, absent) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.appartient("internationalization"); });
+    verifie("traduit(string_view, absent) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.traduit(absent); });
+    verifie("traduit(char*, absent) x1000", 0, [&]() { for (int i = 0; i < 1000; i++) dictionnaire.traduit("internationalization"); });
+    verifie("traduit(string_view, present) : seulement le resultat", allocationsResultat, [&]() { dictionnaire.traduit(present); });
+    verifie("traduit(char*, present) : seulement le resultat", allocationsResultat, [&]() { dictionnaire.traduit("supercalifragilistic"); });
+
+    // Un nouveau mot : le noeud et le vecteur de traductions. Les deux chaînes sont déplacées, pas copiées
+    std::string mot("antidisestablishment"), traduction("antidisestablishmentarianisme");
+    verifie("ajouteMot(string&&, string&&), nouveau mot", 2, [&]() { dictionnaire.ajouteMot(std::move(mot), std::move(traduction)); });
+    std::string mot2("antidisestablishmentarian"), traduction2("antidisestablishmentarien");
+    verifie("ajouteMot(const string&, const string&), nouveau mot", 4, [&]() { dictionnaire.ajouteMot(mot2, traduction2); });
+
+    if (nbEchecs == 0) std::printf("Allocations : toutes les vérifications passent\n");
+    return nbEchecs == 0 ? 0 : 1;
+}
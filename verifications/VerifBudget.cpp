@@ -0,0 +1,139 @@
+/**
+ * \file VerifBudget.cpp
+ * \brief Vérification : suggereCorrections avec budget (évaluations ou délai) retourne un résultat valide
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifBudget (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * Sans limite ou avec un budget généreux, le résultat doit être le vrai top 5 (calculé ici par force brute).
+ * Avec un budget minuscule, il peut être partiel, mais chaque suggestion doit être un mot du dictionnaire
+ * assez similaire, sans doublon, et dans l'ordre de similitude.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+static int nbEchecs = 0;
+
+// Compte un échec si la condition est fausse
+static void verifie(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        std::printf("ECHEC %s\n", message.c_str());
+        nbEchecs++;
+    }
+}
+
+// Le vrai top 5 : tous les mots assez similaires, du plus similaire au moins similaire, puis en ordre alphabétique
+template <typename M>
+static std::vector<std::string> top5(const std::vector<std::string> &mots, const std::string &requete)
+{
+    std::vector<std::pair<double, std::string> > similaires;
+    for (std::size_t i = 0; i < mots.size(); i++)
+    {
+        double sim = Metriques::similitude<M>(requete, mots[i]);
+        if (sim >= M::SEUIL) similaires.push_back(std::make_pair(-sim, mots[i]));
+    }
+    std::sort(similaires.begin(), similaires.end());
+    std::vector<std::string> resultat;
+    for (std::size_t i = 0; i < similaires.size() && i < 5; i++) resultat.push_back(similaires[i].second);
+    return resultat;
+}
+
+// Un résultat partiel est valide : au plus 5 mots distincts du dictionnaire, assez similaires, en ordre de similitude
+template <typename M>
+static void verifiePartiel(Dictionnaire &dictionnaire, const std::string &requete, const std::vector<std::string> &suggestions,
+                           const std::string &contexte)
+{
+    verifie(suggestions.size() <= 5, contexte + " : au plus 5 suggestions");
+    for (std::size_t i = 0; i < suggestions.size(); i++)
+    {
+        verifie(dictionnaire.appartient(suggestions[i]), contexte + " : " + suggestions[i] + " est dans le dictionnaire");
+        verifie(Metriques::similitude<M>(requete, suggestions[i]) >= M::SEUIL, contexte + " : " + suggestions[i] + " assez similaire");
+        if (i > 0)
+        {
+            double avant = Metriques::similitude<M>(requete, suggestions[i - 1]), apres = Metriques::similitude<M>(requete, suggestions[i]);
+            verifie(avant > apres || (avant == apres && suggestions[i - 1] < suggestions[i]), contexte + " : ordre des suggestions");
+        }
+    }
+}
+
+// Vérifie les réglages de budget sur toutes les requêtes, pour la métrique M
+template <typename M>
+static void verifieMetrique(Dictionnaire &dictionnaire, const std::vector<std::string> &mots,
+                            const std::vector<std::string> &requetes, const char *nomMetrique)
+{
+    bool estExhaustif;
+    unsigned int nbInterrompues = 0;
+    for (std::size_t r = 0; r < requetes.size(); r++)
+    {
+        const std::string &requete = requetes[r];
+        std::string contexte = std::string(nomMetrique) + " " + requete;
+        std::vector<std::string> attendu = top5<M>(mots, requete);
+
+        std::vector<std::string> sansLimite = dictionnaire.suggereCorrections(requete, 0, std::chrono::microseconds(0), estExhaustif);
+        verifie(estExhaustif && sansLimite == attendu, contexte + " : sans limite, le vrai top 5");
+
+        std::vector<std::string> genereux = dictionnaire.suggereCorrections(requete, mots.size(), std::chrono::seconds(60), estExhaustif);
+        verifie(estExhaustif && genereux == sansLimite, contexte + " : budget genereux, le resultat sans limite");
+
+        std::vector<std::string> minuscule = dictionnaire.suggereCorrections(requete, 3, std::chrono::microseconds(0), estExhaustif);
+        verifiePartiel<M>(dictionnaire, requete, minuscule, contexte + " budget 3");
+        if (!estExhaustif) nbInterrompues++;
+        else verifie(minuscule == attendu, contexte + " : budget 3 exhaustif, le vrai top 5");
+
+        std::vector<std::string> presse = dictionnaire.suggereCorrections(requete, 0, std::chrono::microseconds(1), estExhaustif);
+        verifiePartiel<M>(dictionnaire, requete, presse, contexte + " delai 1 us");
+    }
+    verifie(nbInterrompues > 0, std::string(nomMetrique) + " : un budget de 3 evaluations interrompt des recherches");
+}
+
+int main()
+{
+    // Des mots synthétiques proches les uns des autres, pour avoir beaucoup de candidats par requête
+    std::mt19937 hasard(11);
+    std::vector<std::string> mots = { "cat", "cart", "care", "case", "cast", "chat", "coat", "act", "house", "mouse",
+                                      "horse", "hose", "receive", "deceive", "relieve", "world", "word", "would", "good", "food" };
+    while (mots.size() < 3000)
+    {
+        std::string mot;
+        for (unsigned int k = 0, longueur = 3 + hasard() % 6; k < longueur; k++) mot += char('a' + hasard() % 8);
+        mots.push_back(mot);
+    }
+    std::sort(mots.begin(), mots.end());
+    mots.erase(std::unique(mots.begin(), mots.end()), mots.end());
+
+    Dictionnaire dictionnaire;
+    for (std::size_t i = 0; i < mots.size(); i++) dictionnaire.ajouteMot(mots[i], "traduction");
+
+    std::vector<std::string> requetes = { "catt", "hte", "wrold", "recieve", "hous", "gosod" };
+    for (int r = 0; r < 20; r++)
+    {
+        std::string requete = mots[hasard() % mots.size()];
+        requete[hasard() % requete.size()] = char('a' + hasard() % 26);
+        if (!dictionnaire.appartient(requete)) requetes.push_back(requete);
+    }
+
+    // Un mot du dictionnaire n'a pas de correction, quel que soit le budget
+    bool estExhaustif = false;
+    verifie(dictionnaire.suggereCorrections("cat", 1, std::chrono::microseconds(1), estExhaustif).empty() && estExhaustif,
+            "mot present : aucune suggestion, recherche exhaustive");
+
+    dictionnaire.choisitMetrique(LEVENSHTEIN);
+    verifieMetrique<Metriques::Levenshtein>(dictionnaire, mots, requetes, "LEVENSHTEIN");
+    dictionnaire.choisitMetrique(DAMERAU_LEVENSHTEIN);
+    verifieMetrique<Metriques::DamerauLevenshtein>(dictionnaire, mots, requetes, "DAMERAU_LEVENSHTEIN");
+    dictionnaire.choisitMetrique(CLAVIER_QWERTY);
+    verifieMetrique<Metriques::ClavierQwerty>(dictionnaire, mots, requetes, "CLAVIER_QWERTY");
+
+    if (nbEchecs == 0) std::printf("Budget : toutes les vérifications passent\n");
+    return nbEchecs == 0 ? 0 : 1;
+}
@@ -0,0 +1,100 @@
+/**
+ * \file VerifCache.cpp
+ * \brief Vérification : avec le cache des mots fréquents, traduit et appartient donnent toujours le résultat de l'arbre
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifCache (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * Une suite aléatoire d'ajouts, de suppressions et de lectures, concentrée sur quelques mots (pour qu'ils
+ * entrent dans le cache), est comparée à un modèle std::map, et au même dictionnaire sans cache.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+static int nbEchecs = 0;
+
+// Compte un échec si la condition est fausse
+static void verifie(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        std::printf("ECHEC %s\n", message.c_str());
+        nbEchecs++;
+    }
+}
+
+// Compare les lectures du dictionnaire au modèle pour un mot
+static void compare(Dictionnaire &dictionnaire, const std::map<std::string, std::vector<std::string> > &modele,
+                    const std::string &mot, const std::string &contexte)
+{
+    std::map<std::string, std::vector<std::string> >::const_iterator trouve = modele.find(mot);
+    bool present = trouve != modele.end();
+    verifie(dictionnaire.appartient(mot) == present, contexte + " : appartient(" + mot + ")");
+    verifie(dictionnaire.traduit(mot) == (present ? trouve->second : std::vector<std::string>()),
+            contexte + " : traduit(" + mot + ")");
+}
+
+int main()
+{
+    // Un mot fréquent est mis en cache, puis modifié : les lectures suivantes doivent voir la modification
+    Dictionnaire dictionnaire;
+    dictionnaire.ajouteMot("cat", "chat");
+    dictionnaire.ajouteMot("dog", "chien");
+    for (int i = 0; i < 1000; i++) dictionnaire.traduit("cat");
+    dictionnaire.ajouteMot("cat", "matou");
+    verifie(dictionnaire.traduit("cat") == std::vector<std::string>({"chat", "matou"}), "traduction ajoutee a un mot en cache");
+    dictionnaire.supprimeMot("cat");
+    verifie(!dictionnaire.appartient("cat") && dictionnaire.traduit("cat").empty(), "mot en cache supprime");
+    dictionnaire.ajouteMot("cat", "minou");
+    verifie(dictionnaire.traduit("cat") == std::vector<std::string>({"minou"}), "mot en cache supprime puis rajoute");
+    for (int i = 0; i < 1000; i++) dictionnaire.appartient("dog");
+    dictionnaire.supprimeMots({"dog"});
+    verifie(!dictionnaire.appartient("dog"), "mot en cache supprime par supprimeMots");
+
+    // Une suite aléatoire : 20 mots chauds (les trois quarts des opérations) parmi 500
+    std::vector<std::string> mots;
+    for (int i = 0; i < 500; i++) mots.push_back("mot" + std::to_string(i));
+    Dictionnaire avecCache, sansCache;
+    sansCache.activeCache(false);
+    std::map<std::string, std::vector<std::string> > modele;
+    std::mt19937 hasard(7);
+    for (int operation = 0; operation < 200000; operation++)
+    {
+        const std::string &mot = mots[(hasard() % 4) ? hasard() % 20 : hasard() % mots.size()];
+        unsigned int choix = hasard() % 10;
+        if (choix == 0)
+        {
+            std::string traduction = "trad" + std::to_string(hasard() % 5);
+            avecCache.ajouteMot(mot, traduction);
+            sansCache.ajouteMot(mot, traduction);
+            std::vector<std::string> &traductions = modele[mot];
+            if (std::find(traductions.begin(), traductions.end(), traduction) == traductions.end()) traductions.push_back(traduction);
+        }
+        else if (choix == 1 && modele.count(mot))
+        {
+            avecCache.supprimeMot(mot);
+            sansCache.supprimeMot(mot);
+            modele.erase(mot);
+        }
+        else
+        {
+            compare(avecCache, modele, mot, "operation " + std::to_string(operation) + " avec cache");
+            compare(sansCache, modele, mot, "operation " + std::to_string(operation) + " sans cache");
+        }
+        if (nbEchecs > 10) break;
+    }
+    for (std::size_t i = 0; i < mots.size(); i++) compare(avecCache, modele, mots[i], "fin");
+    verifie(avecCache.taille() == modele.size() && avecCache.estEquilibre(), "taille et equilibre a la fin");
+
+    if (nbEchecs == 0) std::printf("Cache : toutes les vérifications passent\n");
+    return nbEchecs == 0 ? 0 : 1;
+}
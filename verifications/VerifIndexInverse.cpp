@@ -0,0 +1,129 @@
+/**
+ * \file VerifIndexInverse.cpp
+ * \brief Vérification : l'index inverse (français -> anglais) et ses clés, avant et après des modifications
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifIndexInverse (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * Vérifie les clés d'une traduction (complète, sans article, variantes séparées par '/'), puis compare
+ * traduitInverse à un modèle std::map au fil d'ajouts et de suppressions entremêlés de requêtes inverses.
+ */
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../Dictionnaire.h"
+
+using namespace TP3;
+
+static int nbEchecs = 0;
+
+// Compte un échec si la condition est fausse
+static void verifie(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        std::printf("ECHEC %s\n", message.c_str());
+        nbEchecs++;
+    }
+}
+
+// Compare traduitInverse et appartientInverse d'un mot français aux mots anglais attendus
+static void verifieInverse(Dictionnaire &dictionnaire, const std::string &motFrancais, const std::vector<std::string> &attendus,
+                           const std::string &contexte)
+{
+    verifie(dictionnaire.traduitInverse(motFrancais) == attendus, contexte + " : traduitInverse(" + motFrancais + ")");
+    verifie(dictionnaire.appartientInverse(motFrancais) == !attendus.empty(), contexte + " : appartientInverse(" + motFrancais + ")");
+}
+
+int main()
+{
+    Dictionnaire dictionnaire;
+    dictionnaire.ajouteMot("cat", "le chat");
+    dictionnaire.ajouteMot("kitten", "un chaton");
+    dictionnaire.ajouteMot("dog", "chien/ne");
+    dictionnaire.ajouteMot("abortionist", "avorteur/ avorteuse");
+    dictionnaire.ajouteMot("pacifier", "pacificateur / -trice");
+    dictionnaire.ajouteMot("worker", "l'ouvrier");
+
+    bool exception = false;
+    try
+    {
+        dictionnaire.traduitInverse("chat");
+    }
+    catch (std::logic_error &)
+    {
+        exception = true;
+    }
+    verifie(exception, "traduitInverse sans index : logic_error");
+
+    // Les clés : traduction complète, sans article, et variantes qui ne sont pas de simples terminaisons
+    dictionnaire.activeIndexInverse();
+    verifieInverse(dictionnaire, "le chat", { "cat" }, "cles");
+    verifieInverse(dictionnaire, "chat", { "cat" }, "cles");
+    verifieInverse(dictionnaire, "chaton", { "kitten" }, "cles");
+    verifieInverse(dictionnaire, "un chaton", { "kitten" }, "cles");
+    verifieInverse(dictionnaire, "chien/ne", { "dog" }, "cles");
+    verifieInverse(dictionnaire, "chien", { "dog" }, "cles");
+    verifieInverse(dictionnaire, "ne", {}, "cles");
+    verifieInverse(dictionnaire, "avorteur", { "abortionist" }, "cles");
+    verifieInverse(dictionnaire, "avorteuse", { "abortionist" }, "cles");
+    verifieInverse(dictionnaire, "pacificateur", { "pacifier" }, "cles");
+    verifieInverse(dictionnaire, "-trice", {}, "cles");
+    verifieInverse(dictionnaire, "ouvrier", { "worker" }, "cles");
+    verifieInverse(dictionnaire, "l'ouvrier", { "worker" }, "cles");
+    verifieInverse(dictionnaire, "le", {}, "cles");
+    verifieInverse(dictionnaire, "cat", {}, "cles");
+
+    // Les modifications sont vues par la requête inverse suivante
+    dictionnaire.ajouteMot("tomcat", "le chat");
+    verifieInverse(dictionnaire, "chat", { "cat", "tomcat" }, "apres ajouteMot");
+    dictionnaire.ajouteMot("dog", "le toutou");
+    verifieInverse(dictionnaire, "toutou", { "dog" }, "apres ajouteMot d'une traduction");
+    verifieInverse(dictionnaire, "chien", { "dog" }, "apres ajouteMot d'une traduction");
+    dictionnaire.supprimeMot("cat");
+    verifieInverse(dictionnaire, "chat", { "tomcat" }, "apres supprimeMot");
+    verifieInverse(dictionnaire, "le chat", { "tomcat" }, "apres supprimeMot");
+    dictionnaire.supprimeMots({ "dog", "absent" });
+    verifieInverse(dictionnaire, "chien", {}, "apres supprimeMots");
+    verifieInverse(dictionnaire, "toutou", {}, "apres supprimeMots");
+
+    // Une suite aléatoire d'ajouts et de suppressions, chacun suivi de requêtes inverses, contre un modèle
+    Dictionnaire aleatoire;
+    aleatoire.activeIndexInverse();
+    std::map<std::string, std::set<std::string> > traductions;	// mot anglais -> ses traductions
+    std::mt19937 hasard(3);
+    for (int operation = 0; operation < 3000; operation++)
+    {
+        std::string mot = "en" + std::to_string(hasard() % 200);
+        if (hasard() % 3)
+        {
+            std::string traduction = "fr" + std::to_string(hasard() % 60);
+            aleatoire.ajouteMot(mot, (hasard() % 2) ? "le " + traduction : traduction);
+            traductions[mot].insert(traduction);
+        }
+        else if (traductions.count(mot))
+        {
+            aleatoire.supprimeMot(mot);
+            traductions.erase(mot);
+        }
+
+        for (int requete = 0; requete < 3; requete++)
+        {
+            std::string motFrancais = "fr" + std::to_string(hasard() % 60);
+            std::vector<std::string> attendus;
+            for (std::map<std::string, std::set<std::string> >::const_iterator it = traductions.begin(); it != traductions.end(); ++it)
+                if (it->second.count(motFrancais)) attendus.push_back(it->first);
+            verifieInverse(aleatoire, motFrancais, attendus, "operation " + std::to_string(operation));
+        }
+        if (nbEchecs > 10) break;
+    }
+
+    if (nbEchecs == 0) std::printf("Index inverse : toutes les vérifications passent\n");
+    return nbEchecs == 0 ? 0 : 1;
+}
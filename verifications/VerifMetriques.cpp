@@ -0,0 +1,123 @@
+/**
+ * \file VerifMetriques.cpp
+ * \brief Vérification : distances et similitudes des métriques (Metriques.h) contre des valeurs connues et une matrice complète
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifMetriques (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * Les distances de quelques paires sont connues d'avance. Pour une liste fixe de mots, toutes les paires sont
+ * aussi comparées au calcul d'origine (matrice complète en vector<vector>, coûts en opérations entières),
+ * étendu aux transpositions et aux touches voisines.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../Metriques.h"
+
+using namespace TP3;
+
+static int nbEchecs = 0;
+
+// Compte un échec si la distance calculée n'est pas celle attendue
+template <typename M>
+static void verifieDistance(const char *nomMetrique, const std::string &mot1, const std::string &mot2, unsigned int attendue)
+{
+    unsigned int calculee = Metriques::distance<M>(mot1, mot2);
+    if (calculee != attendue)
+    {
+        std::printf("ECHEC %s(%s, %s) = %u (attendu %u)\n", nomMetrique, mot1.c_str(), mot2.c_str(), calculee, attendue);
+        nbEchecs++;
+    }
+}
+
+// Le calcul d'origine de Dictionnaire::similitude (matrice complète), avec les transpositions et les touches
+// voisines en option. Le coût d'une substitution vient de la table QWERTY, ramenée en opérations.
+static double similitudeReference(const std::string &mot1, const std::string &mot2, bool transpositions, bool clavier)
+{
+    std::size_t len1 = mot1.size(), len2 = mot2.size();
+    std::vector<std::vector<double> > d(len1 + 1, std::vector<double>(len2 + 1));
+    for (std::size_t i = 0; i <= len1; i++) d[i][0] = i;
+    for (std::size_t j = 0; j <= len2; j++) d[0][j] = j;
+    for (std::size_t i = 1; i <= len1; i++)
+    {
+        for (std::size_t j = 1; j <= len2; j++)
+        {
+            double substitution = (mot1[i - 1] == mot2[j - 1]) ? 0 : 1;
+            if (clavier && substitution != 0) substitution = Metriques::ClavierQwerty::substitution(mot1[i - 1], mot2[j - 1]) / double(Metriques::ECHELLE);
+            d[i][j] = std::min({ d[i - 1][j] + 1, d[i][j - 1] + 1, d[i - 1][j - 1] + substitution });
+            if (transpositions && i > 1 && j > 1 && mot1[i - 1] == mot2[j - 2] && mot1[i - 2] == mot2[j - 1])
+                d[i][j] = std::min(d[i][j], d[i - 2][j - 2] + 1);
+        }
+    }
+    double maxlen = std::max(len1, len2);
+    return maxlen == 0 ? 1.0 : 1.0 - d[len1][len2] / maxlen;
+}
+
+int main()
+{
+    const unsigned int E = Metriques::ECHELLE;
+
+    // Des distances connues (en opérations, multipliées par ECHELLE)
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "kitten", "sitting", 3 * E);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "flaw", "lawn", 2 * E);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "", "abc", 3 * E);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "abc", "", 3 * E);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "house", "house", 0);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "teh", "the", 2 * E);
+    verifieDistance<Metriques::Levenshtein>("LEVENSHTEIN", "ca", "abc", 3 * E);
+
+    verifieDistance<Metriques::DamerauLevenshtein>("DAMERAU_LEVENSHTEIN", "teh", "the", E);
+    verifieDistance<Metriques::DamerauLevenshtein>("DAMERAU_LEVENSHTEIN", "recieve", "receive", E);
+    verifieDistance<Metriques::DamerauLevenshtein>("DAMERAU_LEVENSHTEIN", "abcd", "badc", 2 * E);
+    verifieDistance<Metriques::DamerauLevenshtein>("DAMERAU_LEVENSHTEIN", "kitten", "sitting", 3 * E);
+    // Restreinte : une lettre transposée n'est plus modifiée ensuite (la vraie distance de Damerau donnerait 2)
+    verifieDistance<Metriques::DamerauLevenshtein>("DAMERAU_LEVENSHTEIN", "ca", "abc", 3 * E);
+
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "cat", "cst", E / 2);	// a et s sont voisines
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "cat", "cet", E);		// a et e ne le sont pas
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "q", "a", E / 2);		// rangée du dessous
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "w", "a", E / 2);
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "q", "s", E);
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "n", "m", E / 2);
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "p", "q", E);
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "teh", "the", E);
+    verifieDistance<Metriques::ClavierQwerty>("CLAVIER_QWERTY", "wprld", "world", E / 2);	// p et o sont voisines
+
+    // Toutes les paires d'une liste fixe, contre le calcul d'origine
+    const std::vector<std::string> mots = { "", "a", "cat", "act", "chat", "cart", "house", "mouse", "hose", "horse",
+                                            "receive", "recieve", "deceive", "world", "wrold", "would", "good", "gosod",
+                                            "kitten", "sitting", "the", "teh", "hte", "abcdefghijklmnopqrstuvwxyz",
+                                            "zyxwvutsrqponmlkjihgfedcba", "internationalisation", "internationalization",
+                                            std::string(70, 'a'), std::string(69, 'a') + "b", "Cat", "caT" };
+    unsigned int nbPaires = 0;
+    for (std::size_t i = 0; i < mots.size(); i++)
+    {
+        for (std::size_t j = 0; j < mots.size(); j++)
+        {
+            const double attendues[3] = { similitudeReference(mots[i], mots[j], false, false),
+                                          similitudeReference(mots[i], mots[j], true, false),
+                                          similitudeReference(mots[i], mots[j], true, true) };
+            const double calculees[3] = { Metriques::similitude<Metriques::Levenshtein>(mots[i], mots[j]),
+                                          Metriques::similitude<Metriques::DamerauLevenshtein>(mots[i], mots[j]),
+                                          Metriques::similitude<Metriques::ClavierQwerty>(mots[i], mots[j]) };
+            const char *noms[3] = { "LEVENSHTEIN", "DAMERAU_LEVENSHTEIN", "CLAVIER_QWERTY" };
+            for (int m = 0; m < 3; m++)
+            {
+                // Les coûts sont des multiples de 1/2 : les deux calculs sont exacts en double
+                if (calculees[m] != attendues[m])
+                {
+                    std::printf("ECHEC similitude %s(%s, %s) = %g (attendu %g)\n", noms[m], mots[i].c_str(), mots[j].c_str(),
+                                calculees[m], attendues[m]);
+                    nbEchecs++;
+                }
+            }
+            nbPaires++;
+        }
+    }
+
+    if (nbEchecs == 0) std::printf("Metriques : %u paires, toutes les vérifications passent\n", nbPaires);
+    return nbEchecs == 0 ? 0 : 1;
+}
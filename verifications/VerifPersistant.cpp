@@ -0,0 +1,132 @@
+/**
+ * \file VerifPersistant.cpp
+ * \brief Vérification : les versions d'un DictionnairePersistant restent inchangées et se restaurent
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifPersistant (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ * Une suite aléatoire d'ajouts et de suppressions est appliquée au dictionnaire et à un modèle std::map.
+ * Des versions sont gardées en chemin avec une copie du modèle : chacune doit rester égale à sa copie
+ * après toutes les modifications suivantes, et après sa restauration puis de nouvelles modifications.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../DictionnairePersistant.h"
+
+using namespace TP3;
+
+typedef std::map<std::string, std::vector<std::string> > Modele;
+
+static int nbEchecs = 0;
+
+// Compte un échec si la condition est fausse
+static void verifie(bool condition, const std::string &message)
+{
+    if (!condition)
+    {
+        std::printf("ECHEC %s\n", message.c_str());
+        nbEchecs++;
+    }
+}
+
+// Une version est égale au modèle : même taille, mêmes traductions, et arbre équilibré
+static bool estEgale(const DictionnairePersistant::Version &version, const Modele &modele, const std::vector<std::string> &mots)
+{
+    if (version.taille() != modele.size() || version.estVide() != modele.empty() || !version.estEquilibre()) return false;
+    for (std::size_t i = 0; i < mots.size(); i++)
+    {
+        Modele::const_iterator trouve = modele.find(mots[i]);
+        if (version.appartient(mots[i]) != (trouve != modele.end())) return false;
+        if (version.traduit(mots[i]) != (trouve != modele.end() ? trouve->second : std::vector<std::string>())) return false;
+    }
+    return true;
+}
+
+// Un ajout ou une suppression au hasard, sur le dictionnaire et le modèle
+static void modifie(DictionnairePersistant &dictionnaire, Modele &modele, const std::vector<std::string> &mots, std::mt19937 &hasard)
+{
+    const std::string &mot = mots[hasard() % mots.size()];
+    if (hasard() % 3)
+    {
+        std::string traduction = "trad" + std::to_string(hasard() % 4);
+        dictionnaire.ajouteMot(mot, traduction);
+        std::vector<std::string> &traductions = modele[mot];
+        if (std::find(traductions.begin(), traductions.end(), traduction) == traductions.end()) traductions.push_back(traduction);
+    }
+    else
+    {
+        bool exception = false;
+        try
+        {
+            dictionnaire.supprimeMot(mot);
+        }
+        catch (std::logic_error &)
+        {
+            exception = true;
+        }
+        verifie(exception == (modele.count(mot) == 0), "supprimeMot(" + mot + ") : exception si et seulement si le mot est absent");
+        modele.erase(mot);
+    }
+}
+
+int main()
+{
+    std::vector<std::string> mots;
+    for (int i = 0; i < 600; i++) mots.push_back("mot" + std::to_string(i));
+
+    // Des versions gardées en chemin, avec la copie du modèle à ce moment
+    std::mt19937 hasard(5);
+    DictionnairePersistant dictionnaire;
+    Modele modele;
+    std::vector<std::pair<DictionnairePersistant::Version, Modele> > versions;
+    versions.push_back(std::make_pair(dictionnaire.versionCourante(), modele));
+    for (int operation = 1; operation <= 20000; operation++)
+    {
+        modifie(dictionnaire, modele, mots, hasard);
+        if (operation % 1000 == 0) versions.push_back(std::make_pair(dictionnaire.versionCourante(), modele));
+    }
+    verifie(estEgale(dictionnaire.versionCourante(), modele, mots), "version courante apres 20000 modifications");
+    for (std::size_t v = 0; v < versions.size(); v++)
+        verifie(estEgale(versions[v].first, versions[v].second, mots), "version " + std::to_string(v) + " inchangee apres les modifications suivantes");
+
+    // Restaurer une ancienne version, la modifier : les autres versions (et celle restaurée) ne bougent pas
+    for (std::size_t v : { std::size_t(5), std::size_t(0), versions.size() - 1 })
+    {
+        dictionnaire.restaure(versions[v].first);
+        verifie(estEgale(dictionnaire.versionCourante(), versions[v].second, mots), "restaure(version " + std::to_string(v) + ")");
+        verifie(dictionnaire.taille() == versions[v].second.size(), "taille apres restaure(version " + std::to_string(v) + ")");
+
+        Modele branche = versions[v].second;
+        for (int operation = 0; operation < 2000; operation++) modifie(dictionnaire, branche, mots, hasard);
+        verifie(estEgale(dictionnaire.versionCourante(), branche, mots), "modifications apres restaure(version " + std::to_string(v) + ")");
+        for (std::size_t autre = 0; autre < versions.size(); autre++)
+            verifie(estEgale(versions[autre].first, versions[autre].second, mots),
+                    "version " + std::to_string(autre) + " inchangee apres modification de la version " + std::to_string(v) + " restauree");
+    }
+
+    // Une version vide reste vide, et une version copiée d'un Dictionnaire en garde les mots
+    verifie(versions[0].first.estVide() && versions[0].first.taille() == 0, "version initiale vide");
+    Dictionnaire source;
+    source.ajouteMot("cat", "chat");
+    source.ajouteMot("cat", "matou");
+    source.ajouteMot("dog", "chien");
+    DictionnairePersistant copie(source);
+    DictionnairePersistant::Version avant = copie.versionCourante();
+    copie.supprimeMot("cat");
+    copie.ajouteMot("dog", "toutou");
+    source.supprimeMot("dog");
+    verifie(avant.traduit("cat") == std::vector<std::string>({ "chat", "matou" }) && avant.traduit("dog") == std::vector<std::string>({ "chien" }),
+            "version copiee d'un Dictionnaire inchangee");
+    verifie(!copie.appartient("cat") && copie.traduit("dog") == std::vector<std::string>({ "chien", "toutou" }),
+            "modifications de la copie");
+
+    if (nbEchecs == 0) std::printf("Persistant : %zu versions, toutes les vérifications passent\n", versions.size());
+    return nbEchecs == 0 ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/**
+ * \file VerifTokeniseur.cpp
+ * \brief Vérification : le Tokeniseur donne les mêmes mots avec et sans le chemin SSE2, et rejette l'UTF-8 invalide
+ * \author IFT-2008, Étudiant(e)
+ * \version 0.1
+ * \date avril 2023
+ *
+ * Usage : VerifTokeniseur (lancé par ctest). Retourne 0 si toutes les vérifications passent.
+ */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Tokeniseur.h"
+
+using namespace TP3;
+
+static int nbEchecs = 0;
+
+// Une représentation lisible d'un texte (octets non ASCII en hexadécimal)
+static std::string lisible(const std::string &texte)
+{
+    static const char chiffres[] = "0123456789ABCDEF";
+    std::string resultat;
+    for (std::size_t i = 0; i < texte.size(); i++)
+    {
+        unsigned char c = texte[i];
+        if (c >= 0x20 && c < 0x7F) resultat += char(c);
+        else resultat += std::string("\\x") + chiffres[c >> 4] + chiffres[c & 0xF];
+    }
+    return resultat;
+}
+
+// Les mots d'un texte, copiés (les vues du Tokeniseur ne survivent pas au prochain appel)
+static std::vector<std::string> mots(Tokeniseur &tokeniseur, const std::string &texte)
+{
+    const std::vector<std::string_view> &vues = tokeniseur.decoupe(texte);
+    return std::vector<std::string>(vues.begin(), vues.end());
+}
+
+// Les deux chemins doivent donner les mêmes mots. Si attendus n'est pas vide, ce doit être ces mots-là
+static void verifie(const std::string &texte, const std::vector<std::string> &attendus = std::vector<std::string>())
+{
+    Tokeniseur vectoriel(true), scalaire(false);
+    std::vector<std::string> motsVectoriel = mots(vectoriel, texte), motsScalaire = mots(scalaire, texte);
+    if (motsVectoriel != motsScalaire)
+    {
+        std::cout << "ECHEC (SSE2 et scalaire diffèrent) : " << lisible(texte) << std::endl;
+        nbEchecs++;
+    }
+    else if (!attendus.empty() && motsScalaire != attendus)
+    {
+        std::cout << "ECHEC (mots inattendus) : " << lisible(texte) << " ->";
+        for (std::size_t i = 0; i < motsScalaire.size(); i++) std::cout << " [" << lisible(motsScalaire[i]) << "]";
+        std::cout << std::endl;
+        nbEchecs++;
+    }
+}
+
+int main()
+{
+    // Un texte de plus de 16 octets ASCII autour d'un cas passe aussi par le chemin SSE2
+    const std::string remplissage = "Lorem Ipsum Dolor ";
+
+    // Premiers octets invalides : F5-FF, C0, C1 et octets de continuation seuls
+    verifie("ab\xF8\x80\x80" "cd", { "ab", "cd" });
+    verifie(remplissage + "ab\xF8\x80\x80" "cd " + remplissage, { "lorem", "ipsum", "dolor", "ab", "cd", "lorem", "ipsum", "dolor" });
+    verifie("ab\xF5\x80\x80\x80" "cd", { "ab", "cd" });
+    verifie("ab\xFF" "cd", { "ab", "cd" });
+    verifie("ab\xC0\xAF" "cd", { "ab", "cd" });
+    verifie("ab\x80" "cd", { "ab", "cd" });
+
+    // Formes trop longues, substituts UTF-16, valeurs au-delà de U+10FFFF
+    verifie("ab\xE0\x80\xAF" "cd", { "ab", "cd" });
+    verifie("ab\xED\xA0\x80" "cd", { "ab", "cd" });
+    verifie("ab\xF0\x80\x80\xAF" "cd", { "ab", "cd" });
+    verifie("ab\xF4\x90\x80\x80" "cd", { "ab", "cd" });
+
+    // Séquences valides : accents retirés, autres caractères gardés tels quels, séquence tronquée
+    verifie("\xC3\x89t\xC3\xA9 c\xC5\x93ur", { "ete", "coeur" });
+    verifie("ab\xE0\xA0\x80" "cd", { "ab\xE0\xA0\x80" "cd" });
+    verifie("ab\xED\x9F\xBF" "cd", { "ab\xED\x9F\xBF" "cd" });
+    verifie("ab\xF0\x9F\x98\x80" "cd", { "ab\xF0\x9F\x98\x80" "cd" });
+    verifie("ab\xF4\x8F\xBF\xBF" "cd", { "ab\xF4\x8F\xBF\xBF" "cd" });
+    verifie("c\xE2\x80\x99mon ma'am", { "c'mon", "ma'am" });
+    verifie("ab\xE2\x82", { "ab" });
+
+    // Textes au hasard : octets quelconques, puis surtout ASCII avec quelques octets non ASCII
+    std::mt19937 hasard(2023);
+    for (unsigned int essai = 0; essai < 20000; essai++)
+    {
+        std::string texte(hasard() % 64, ' ');
+        bool surtoutAscii = essai % 2;
+        for (std::size_t i = 0; i < texte.size(); i++)
+        {
+            unsigned int octet = hasard() % 256;
+            if (surtoutAscii && hasard() % 8) octet %= 128;
+            texte[i] = char(octet);
+        }
+        verifie(texte);
+    }
+
+    if (nbEchecs == 0) std::cout << "Tokeniseur : toutes les vérifications passent" << std::endl;
+    return nbEchecs == 0 ? 0 : 1;
+}